@@ -0,0 +1,108 @@
+/** @file ai.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief computer catcher
+ */
+
+#ifdef AI
+
+#include "system.h"
+#include "tinygl.h"
+#include "boing.h"
+#include "ball.h"
+#include "level.h"
+#include "movement.h"
+#include "ai.h"
+
+#define AI_ROWS TINYGL_HEIGHT // a paddle turns through as many places as there are rows
+#define AI_CERTAIN 256        // weight of a sure thing
+
+
+#if AI >= 3
+/*
+ * Spread the chance of the ball being on each row over one more move of
+ * random wind, bouncing off the edges as boing does.
+ * @param weight - chance of each row, AI_CERTAIN in all
+ */
+static void ai_blow (uint16_t* weight)
+{
+    uint16_t next[AI_ROWS] = {0};
+    uint8_t row;
+    uint16_t gust;
+    uint8_t threshold = level_jump_threshold ();
+
+    for (row = 0; row < AI_ROWS; row++) {
+        if (!weight[row]) {
+            continue;
+        }
+        gust = (weight[row] * threshold) >> 8;
+        next[row] += weight[row] - 2 * gust;
+        next[row + 1 < AI_ROWS ? row + 1 : row - 1] += gust; // south
+        next[row > 0 ? row - 1 : row + 1] += gust;           // north
+    }
+    for (row = 0; row < AI_ROWS; row++) {
+        weight[row] = next[row];
+    }
+}
+#endif
+
+
+uint8_t ai_target (boing_state_t ball, uint8_t paddle)
+{
+    uint16_t weight[AI_ROWS] = {0};
+    uint16_t best = 0, cover;
+    uint8_t target = paddle;
+    uint8_t south, turns, best_turns = 0;
+    uint8_t row;
+
+#if AI == 1
+    weight[ball.pos.y] = AI_CERTAIN;
+#else
+    uint8_t moves = TINYGL_WIDTH - 1 - ball.pos.x;
+
+    if (moves) {
+        ball = boing_update (ball); // it has been blown along this move already
+        moves--;
+    }
+    weight[ball.pos.y] = AI_CERTAIN;
+#if AI >= 3
+    while (moves--) {
+        ai_blow (weight);
+    }
+#endif
+#endif
+
+    for (south = 0; south < AI_ROWS; south++) { // each place the paddle turns through
+        cover = 0;
+        for (row = 0; row < AI_ROWS; row++) {
+            if (catcherCovers (paddle, row)) {
+                cover += weight[row];
+            }
+        }
+        turns = south <= AI_ROWS / 2 ? south : AI_ROWS - south; // the shorter way round
+        if (cover > best || (cover == best && turns < best_turns)) {
+            best = cover;
+            best_turns = turns;
+            target = paddle;
+        }
+        paddle = rotatePaddle (paddle, 'S');
+    }
+    return target;
+}
+
+
+char ai_move (uint8_t paddle, uint8_t target)
+{
+    uint8_t south = 0;
+
+    while (paddle != target && south < AI_ROWS) {
+        paddle = rotatePaddle (paddle, 'S');
+        south++;
+    }
+    if (!south || south == AI_ROWS) { // there already, or not a place this paddle can get to
+        return 0;
+    }
+    return south <= AI_ROWS / 2 ? 'S' : 'N';
+}
+
+#endif
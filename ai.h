@@ -0,0 +1,52 @@
+/** @file ai.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief computer catcher, only built in when AI is defined (make AI=1, 2
+ *  or 3 for the skill level). It moves this board's paddle in place of the
+ *  navswitch whenever this board is the catcher, so one person can play
+ *  against the board and the simulator gets an opponent that tries.
+ *
+ *  The ball already points along its next move, after that each move it is
+ *  blown north or south with the level's chance, see level.h. Skill 1
+ *  follows the row the ball is on, skill 2 aims for the row after the
+ *  ball's next move as if there were no more wind, and skill 3 works out the
+ *  chance of the ball landing on each row and puts the paddle where it
+ *  covers the most of it, however wide the level makes it. Higher skills also
+ *  react sooner. A prediction costs a few dozen multiplies at most and is
+ *  only made when the paddle is free to move.
+ */
+
+#ifndef AI_H
+#define AI_H
+
+#include "system.h"
+#include "tinygl.h"
+#include "boing.h"
+
+#if AI == 1
+#define AI_REACTION_MS 380 // [ms] between paddle moves, set for a two dot paddle that turns over the edges
+#elif AI == 2
+#define AI_REACTION_MS 260
+#else
+#define AI_REACTION_MS 150
+#endif
+
+/*
+ * Paddle position to head for.
+ * @param ball - the ball nearest the paddle, pointing along its next move
+ * @param paddle - rows the paddle covers now
+ * returns the rows of the paddle position most likely to catch the ball,
+ * the nearest one when there is a tie
+ */
+uint8_t ai_target (boing_state_t ball, uint8_t paddle);
+
+/*
+ * Which way to move the paddle, it turns round from one edge to the other
+ * so the shorter way may be over the edge.
+ * @param paddle - rows the paddle covers now
+ * @param target - rows from ai_target, or the paddle's home
+ * returns 'N', 'S' or 0 to stay
+ */
+char ai_move (uint8_t paddle, uint8_t target);
+
+#endif
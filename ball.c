@@ -9,11 +9,81 @@
 #include "tinygl.h"
 #include "boing.h"
 #include <stdlib.h>
+#include "frame.h"
+#include "prng.h"
+#include "level.h"
 #include "ball.h"
 
 #define NUM_ROWS 7
 #define NUM_COLUMNS 5
-#define JUMP_CHANCE 15 // [%] probability of ball jumping to different column
+#define BALL_RAMP_AFTER 3 // throws at the level's speed before they start getting faster
+#define BALL_RAMP_STEP (BALL_SPEED_ONE / 2) // speed added for each throw after that
+#define BALL_SPEED_MAX (15 * BALL_SPEED_ONE) // a round with lost balls can run to many more throws
+
+#define DRIFT_NONE 0
+#define DRIFT_SOUTH 1
+#define DRIFT_NORTH 2
+#define DRIFT_BITS 2
+#define DRIFT_MASK 3
+
+#ifdef BALL_PATH
+/* planned flight, 2 bits of drift per move with move 0 in the low bits */
+static uint16_t ball_path;
+static uint8_t ball_path_move;
+static tinygl_coord_t ball_path_row;
+#endif
+
+
+/*
+ * Roll the wind gust for the ball's next move, one random byte compared against
+ * thresholds so there is no modulo.
+ * returns DRIFT_NONE, DRIFT_SOUTH or DRIFT_NORTH
+ */
+static uint8_t rollDrift(void) {
+    uint8_t  rand_num = prng_next();
+    uint8_t threshold = level_jump_threshold();
+
+    // the level's chance of changing direction each way
+    if (rand_num < threshold){
+        return DRIFT_SOUTH;
+    } else if (rand_num >= (256-threshold)){
+        return DRIFT_NORTH;
+    }
+    return DRIFT_NONE;
+}
+
+
+/*
+ * Drift for the ball's next move, rolled now or read from the planned path.
+ */
+static uint8_t nextDrift(void) {
+#ifdef BALL_PATH
+    uint8_t drift = (ball_path >> (ball_path_move * DRIFT_BITS)) & DRIFT_MASK;
+    if (ball_path_move < BALL_PATH_MOVES) {
+        ball_path_move++;
+    }
+    return drift;
+#else
+    return rollDrift();
+#endif
+}
+
+
+/*
+ * Turns a drift into a direction of travel.
+ * @param drift - DRIFT_NONE, DRIFT_SOUTH or DRIFT_NORTH
+ * @param straight - direction with no drift
+ * @param south - direction when drifting south
+ * @param north - direction when drifting north
+ */
+static boing_dir_t driftDirection(uint8_t drift, boing_dir_t straight, boing_dir_t south, boing_dir_t north) {
+    if (drift == DRIFT_SOUTH) {
+        return south;
+    } else if (drift == DRIFT_NORTH) {
+        return north;
+    }
+    return straight;
+}
 
 
  /*
@@ -24,9 +94,9 @@
  */
 void setBallPositionOnShooter(boing_state_t* ball_ptr, tinygl_coord_t value, bool ball_fired) {
     if (!ball_fired) {
-        tinygl_draw_point ((*ball_ptr).pos, 0);
+        frame_draw_point ((*ball_ptr).pos, 0);
         (*ball_ptr).pos.y = value;
-        tinygl_draw_point ((*ball_ptr).pos, 1); 
+        frame_draw_point ((*ball_ptr).pos, 1); 
     }
 }
 
@@ -52,27 +122,15 @@ void resetBallNextPlayer(boing_state_t* ball_ptr) {
  */
 void updateFiredBallShooter(boing_state_t* ball_ptr) {
     
-    //declare and initialise variables
-    uint8_t  rand_num;
-    
-    //remove previous ball position
-    tinygl_draw_point (ball_ptr->pos, 0);
+    //remove previous ball position, leaving a trail
+    frame_trail (ball_ptr->pos);
     
     // move the ball if it has not reached the end of the screen
     if ((*ball_ptr).pos.x != 0){
                     
         *ball_ptr = boing_update(*ball_ptr);
-        tinygl_draw_point ((*ball_ptr).pos, 1);
-        (*ball_ptr).dir = DIR_W;
-                    
-        // generate random number in [1, 100]
-        rand_num = rand() % 100 + 1;
-        // 15% chance of changing direction
-        if (rand_num < JUMP_CHANCE){
-            (*ball_ptr).dir = DIR_SW;
-        } else if (rand_num > (100-JUMP_CHANCE)){
-           (*ball_ptr).dir = DIR_NW;
-        }
+        frame_draw_point ((*ball_ptr).pos, 1);
+        (*ball_ptr).dir = driftDirection(nextDrift(), DIR_W, DIR_SW, DIR_NW);
     } else {
         (*ball_ptr).pos.y = 1;
     }
@@ -87,28 +145,246 @@ void updateFiredBallShooter(boing_state_t* ball_ptr) {
  */
 void updateFiredBallCatcher(boing_state_t* ball_ptr){
     
-    //declare and initialise variables
-    uint8_t  rand_num;
-    
-    //remove previous ball position
-    tinygl_draw_point (ball_ptr->pos, 0);
+    //remove previous ball position, leaving a trail
+    frame_trail (ball_ptr->pos);
     
     // move the ball if it has not reached the end of the screen
     if ((*ball_ptr).pos.x != NUM_COLUMNS-1){
         
         *ball_ptr = boing_update(*ball_ptr);
-        tinygl_draw_point ((*ball_ptr).pos, 1);
-        (*ball_ptr).dir = DIR_E;
-        
-                    
-        // generate random number in [1, 100]
-        rand_num = rand() % 100 + 1;
-        // 15% chance of changing direction
-        if (rand_num < JUMP_CHANCE){
-            (*ball_ptr).dir = DIR_SE;
-        } else if (rand_num > (100-JUMP_CHANCE)){
-           (*ball_ptr).dir = DIR_NE;
-        }
+        frame_draw_point ((*ball_ptr).pos, 1);
+        (*ball_ptr).dir = driftDirection(nextDrift(), DIR_E, DIR_SE, DIR_NE);
     }
     
 }
+
+
+
+uint8_t ballThrowSpeed(uint8_t throw_number) {
+    uint16_t speed = level_ball_speed() * BALL_SPEED_ONE;
+
+    if (throw_number > BALL_RAMP_AFTER) {
+        speed += (throw_number - BALL_RAMP_AFTER) * BALL_RAMP_STEP;
+    }
+    if (speed > BALL_SPEED_MAX) {
+        speed = BALL_SPEED_MAX;
+    }
+    return speed;
+}
+
+
+
+
+void ballMotionStart(ball_motion_t* motion, uint8_t speed) {
+    motion->progress = 0;
+    motion->speed = speed;
+}
+
+
+
+
+/*
+ * Adds one tick's worth of the speed, at most a dot per tick as speeds stay
+ * under BALL_TICK_RATE dots per second.
+ */
+bool ballMotionAdvance(ball_motion_t* motion) {
+    motion->progress += motion->speed;
+    if (motion->progress >= BALL_PROGRESS_DOT) {
+        motion->progress -= BALL_PROGRESS_DOT;
+        return 1;
+    }
+    return 0;
+}
+
+
+
+
+void ballMotionSkip(ball_motion_t* motion, uint8_t ticks) {
+    motion->progress += (uint16_t) motion->speed * ticks;
+}
+
+
+
+#ifdef MULTI_BALL
+
+uint8_t ballPoolAdd(ball_pool_t* pool, boing_state_t ball, uint8_t speed) {
+    uint8_t slot;
+
+    for (slot = 0; slot < BALL_POOL_SIZE; slot++) {
+        if (!(pool->live & (1 << slot))) {
+            pool->ball[slot] = ball;
+            ballMotionStart(&pool->motion[slot], speed);
+            pool->live |= 1 << slot;
+            frame_draw_point (ball.pos, 1);
+            break;
+        }
+    }
+    return slot;
+}
+
+
+
+
+/*
+ * Draws every ball still in the air, after they have all been moved so one
+ * ball leaving a dot does not blank another that is on it
+ */
+static void drawBallPool(const ball_pool_t* pool) {
+    uint8_t slot;
+
+    for (slot = 0; slot < BALL_POOL_SIZE; slot++) {
+        if (pool->live & (1 << slot)) {
+            frame_draw_point (pool->ball[slot].pos, 1);
+        }
+    }
+}
+
+
+
+
+uint8_t ballPoolAdvanceShooter(ball_pool_t* pool) {
+    uint8_t left = 0;
+    uint8_t slot;
+
+    for (slot = 0; slot < BALL_POOL_SIZE; slot++) {
+        if (!(pool->live & (1 << slot)) || !ballMotionAdvance(&pool->motion[slot])) {
+            continue;
+        }
+        frame_trail (pool->ball[slot].pos);
+        if (pool->ball[slot].pos.x != 0) {
+            pool->ball[slot] = boing_update(pool->ball[slot]);
+            pool->ball[slot].dir = driftDirection(rollDrift(), DIR_W, DIR_SW, DIR_NW);
+        } else { // a step at the edge, then it is over to the catcher
+            pool->live &= ~(1 << slot);
+            left |= 1 << slot;
+        }
+    }
+    drawBallPool(pool);
+    return left;
+}
+
+
+
+
+uint8_t ballPoolAdvanceCatcher(ball_pool_t* pool) {
+    uint8_t arrived = 0;
+    uint8_t slot;
+
+    for (slot = 0; slot < BALL_POOL_SIZE; slot++) {
+        if (!(pool->live & (1 << slot)) || !ballMotionAdvance(&pool->motion[slot])) {
+            continue;
+        }
+        frame_trail (pool->ball[slot].pos);
+        if (pool->ball[slot].pos.x != NUM_COLUMNS - 1) {
+            pool->ball[slot] = boing_update(pool->ball[slot]);
+            pool->ball[slot].dir = driftDirection(rollDrift(), DIR_E, DIR_SE, DIR_NE);
+            if (pool->ball[slot].pos.x == NUM_COLUMNS - 1) {
+                arrived |= 1 << slot;
+            }
+        } else { // it has been past the paddle for a step
+            pool->live &= ~(1 << slot);
+        }
+    }
+    drawBallPool(pool);
+    return arrived;
+}
+
+
+
+
+void ballPoolClear(ball_pool_t* pool) {
+    pool->live = 0;
+}
+
+#endif
+
+
+
+#ifdef BALL_PATH
+
+/*
+ * Drift planned for one move of the flight.
+ * @param move - move number, counting from the shot
+ */
+static uint8_t pathDrift(uint8_t move) {
+    return (ball_path >> (move * DRIFT_BITS)) & DRIFT_MASK;
+}
+
+
+
+
+/*
+ * Plans the whole flight of a ball that is about to be fired, across both screens,
+ * and points the ball along its first move
+ * @param ball_ptr - pointer to the loaded ball
+ */
+void planBallPath(boing_state_t* ball_ptr) {
+    uint8_t move;
+
+    ball_path = 0;
+    for (move = 0; move < BALL_PATH_MOVES; move++) {
+        ball_path |= (uint16_t) rollDrift() << (move * DRIFT_BITS);
+    }
+    ball_path_row = (*ball_ptr).pos.y;
+    ball_path_move = 0;
+    (*ball_ptr).dir = driftDirection(nextDrift(), DIR_W, DIR_SW, DIR_NW);
+}
+
+
+
+
+/*
+ * Packs the planned path into a message payload, the start row then the drifts
+ * @param payload - BALL_PATH_SIZE bytes to fill
+ */
+void encodeBallPath(uint8_t* payload) {
+    payload[0] = ball_path_row;
+    payload[1] = ball_path & 0xFF;
+    payload[2] = ball_path >> 8;
+}
+
+
+
+
+/*
+ * Takes on the path the shooter planned
+ * @param payload - BALL_PATH_SIZE bytes from encodeBallPath
+ */
+void decodeBallPath(const uint8_t* payload) {
+    ball_path_row = payload[0];
+    ball_path = payload[1] | (uint16_t) payload[2] << 8;
+    ball_path_move = 0;
+}
+
+
+
+
+/*
+ * Row the planned ball leaves the shooter's screen on, found by flying the
+ * shooter's moves the same way updateFiredBallShooter does
+ */
+tinygl_coord_t ballPathExitRow(void) {
+    boing_state_t ball = boing_init(NUM_COLUMNS - 2, ball_path_row, DIR_W);
+    uint8_t move;
+
+    for (move = 0; move < BALL_PATH_SHOOTER_MOVES; move++) {
+        ball.dir = driftDirection(pathDrift(move), DIR_W, DIR_SW, DIR_NW);
+        ball = boing_update(ball);
+    }
+    return ball.pos.y;
+}
+
+
+
+
+/*
+ * Points a ball that has just come onto the catcher's screen along the rest of
+ * the planned path
+ * @param ball_ptr - pointer to the received ball
+ */
+void enterBallPath(boing_state_t* ball_ptr) {
+    ball_path_move = BALL_PATH_SHOOTER_MOVES;
+    (*ball_ptr).dir = driftDirection(nextDrift(), DIR_E, DIR_SE, DIR_NE);
+}
+
+#endif
@@ -14,6 +14,48 @@
 #include <stdlib.h>
 #include "ball.h"
 
+/* With BALL_PATH defined the shooter plans every move of a ball's flight when it
+   fires and sends the plan to the catcher, which replays it instead of rolling
+   its own wind gusts. */
+#define BALL_PATH_SHOOTER_MOVES (TINYGL_WIDTH - 2)
+#define BALL_PATH_MOVES (BALL_PATH_SHOOTER_MOVES + TINYGL_WIDTH - 1)
+#define BALL_PATH_SIZE 3 // [bytes] start row and 2 bits of drift per move
+
+/* With MULTI_BALL defined the shooter can have up to BALL_POOL_SIZE balls in the
+   air at once. The balls live in a fixed pool that is stepped in one pass a tick. */
+#define BALL_POOL_SIZE 4
+
+#if defined (BALL_PATH) && defined (MULTI_BALL)
+#error "BALL_PATH plans one ball at a time, it cannot be built with MULTI_BALL"
+#endif
+
+/* Ball speeds are dots per second in fixed point, BALL_SPEED_ONE is one dot per
+   second. Both boards move the ball on at BALL_TICK_RATE whatever else they run at. */
+#define BALL_SPEED_ONE 16
+#define BALL_TICK_RATE 100 // [Hz] rate of ballMotionAdvance
+#define BALL_PROGRESS_DOT (BALL_SPEED_ONE * BALL_TICK_RATE)
+
+/*
+ * How far a ball has got towards its next dot
+ * progress: BALL_PROGRESS_DOT is a whole dot
+ * speed: dots per second, in BALL_SPEED_ONE units
+ */
+typedef struct ball_motion_s
+{
+    uint16_t progress;
+    uint8_t speed;
+} ball_motion_t;
+
+/*
+ * Balls in the air, slot n is in use while bit n of live is set
+ */
+typedef struct ball_pool_s
+{
+    boing_state_t ball[BALL_POOL_SIZE];
+    ball_motion_t motion[BALL_POOL_SIZE];
+    uint8_t live;
+} ball_pool_t;
+
  /*
  * Updates the position of the fired ball as it moves across the schooters screen
  * @param ball_ptr - pointer to the ball, which has a special structure from the boing module
@@ -40,4 +82,96 @@ void resetBallNextPlayer(boing_state_t* ball_ptr);
 */
 void updateFiredBallCatcher(boing_state_t* ball_ptr);
 
+/*
+ * Speed of a throw, the first few of a round go at the level's speed and each
+ * one after that a little faster, up to a top speed
+ * @param throw_number - throws so far this round, counting this one
+ * returns the speed in BALL_SPEED_ONE units
+*/
+uint8_t ballThrowSpeed(uint8_t throw_number);
+
+/*
+ * Starts a ball moving from a whole dot
+ * @param motion - the ball's motion
+ * @param speed - dots per second, in BALL_SPEED_ONE units
+*/
+void ballMotionStart(ball_motion_t* motion, uint8_t speed);
+
+/*
+ * Moves the ball on by one tick, call at BALL_TICK_RATE
+ * @param motion - the ball's motion
+ * returns 1 when the ball has reached its next dot
+*/
+bool ballMotionAdvance(ball_motion_t* motion);
+
+/*
+ * Moves the ball on by ticks that went by before it was seen, a dot or more
+ * is caught up one dot per advance after this
+ * @param motion - the ball's motion
+ * @param ticks - ticks missed
+*/
+void ballMotionSkip(ball_motion_t* motion, uint8_t ticks);
+
+/*
+ * Puts a ball in a free slot of the pool and draws it
+ * @param pool - the pool
+ * @param ball - the ball, pointing the way it is going
+ * @param speed - dots per second, in BALL_SPEED_ONE units
+ * returns the slot, BALL_POOL_SIZE when the pool is full
+*/
+uint8_t ballPoolAdd(ball_pool_t* pool, boing_state_t ball, uint8_t speed);
+
+/*
+ * Moves every ball in the pool on by one tick across the shooter's screen
+ * @param pool - the pool
+ * returns a bit per slot for the balls that left the screen this tick, their
+ * slots are free again but still hold the row they left on and their speed
+*/
+uint8_t ballPoolAdvanceShooter(ball_pool_t* pool);
+
+/*
+ * Moves every ball in the pool on by one tick across the catcher's screen, a
+ * ball stays a step in the last column before it is gone
+ * @param pool - the pool
+ * returns a bit per slot for the balls that reached the last column this tick
+*/
+uint8_t ballPoolAdvanceCatcher(ball_pool_t* pool);
+
+/*
+ * Empties the pool at the end of a round
+ * @param pool - the pool
+*/
+void ballPoolClear(ball_pool_t* pool);
+
+/*
+ * Plans the whole flight of a ball that is about to be fired, across both screens,
+ * and points the ball along its first move
+ * @param ball_ptr - pointer to the loaded ball
+*/
+void planBallPath(boing_state_t* ball_ptr);
+
+/*
+ * Packs the planned path into a message payload, the start row then the drifts
+ * @param payload - BALL_PATH_SIZE bytes to fill
+*/
+void encodeBallPath(uint8_t* payload);
+
+/*
+ * Takes on the path the shooter planned
+ * @param payload - BALL_PATH_SIZE bytes from encodeBallPath
+*/
+void decodeBallPath(const uint8_t* payload);
+
+/*
+ * Row the planned ball leaves the shooter's screen on
+*/
+tinygl_coord_t ballPathExitRow(void);
+
+/*
+ * Points a ball that has just come onto the catcher's screen along the rest of
+ * the planned path
+ * @param ball_ptr - pointer to the received ball
+*/
+void enterBallPath(boing_state_t* ball_ptr);
+
 #endif
@@ -0,0 +1,40 @@
+/** @file boot.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief timestamps of the power up
+ */
+
+#include "system.h"
+#include "timer.h"
+#include "boot.h"
+
+static timer_tick_t boot_marks[BOOT_NUM_PHASES];
+static uint8_t boot_marked; // bit n is set once phase n is marked
+
+
+void boot_init (void)
+{
+    boot_marked = 0;
+}
+
+
+void boot_mark (boot_phase_t phase)
+{
+    if (boot_marked & (1 << phase)) {
+        return;
+    }
+    boot_marks[phase] = timer_get ();
+    boot_marked |= 1 << phase;
+}
+
+
+uint16_t boot_time (boot_phase_t phase)
+{
+    uint32_t us;
+
+    if (!(boot_marked & (1 << phase))) {
+        return BOOT_NOT_YET;
+    }
+    us = (uint32_t) boot_marks[phase] * 1000000 / TIMER_RATE;
+    return us < BOOT_NOT_YET ? us : BOOT_NOT_YET - 1;
+}
@@ -0,0 +1,53 @@
+/** @file boot.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief timestamps of the power up, taken as each part of the board comes
+ *  up so a slow start can be put down to the part that took the time. The
+ *  display comes up first and shows the first screen before anything else
+ *  starts, and the IR link only starts on the first frame sent or looked
+ *  for, so its phase is marked whenever that happens.
+ *
+ *  Times are timer counts from timer_init, the clock setup before it is not
+ *  seen. Each phase is marked once and the diagnostics screen shows them.
+ */
+
+#ifndef BOOT_H
+#define BOOT_H
+
+#include "system.h"
+#include "timer.h"
+
+/* not marked yet */
+#define BOOT_NOT_YET 0xFFFF
+
+typedef enum boot_phase
+{
+    BOOT_CLOCK,       // the timer is running, the scheduler can sleep on it
+    BOOT_DISPLAY,     // the scan interrupt is driving the LEDs
+    BOOT_FIRST_FRAME, // the first screen has been handed to the scan
+    BOOT_INPUT,       // the navswitch is being watched
+    BOOT_READY,       // everything the first screen needs, the game loop starts
+    BOOT_IR,          // the IR link has started, on its first use
+    BOOT_NUM_PHASES
+} boot_phase_t;
+
+
+/*
+ * Forget the phases marked, call before the first.
+ */
+void boot_init (void);
+
+/*
+ * Mark a phase as done now, a phase already marked keeps its first time.
+ * @param phase - the phase
+ */
+void boot_mark (boot_phase_t phase);
+
+/*
+ * When a phase was done.
+ * @param phase - the phase
+ * returns microseconds from timer_init, or BOOT_NOT_YET
+ */
+uint16_t boot_time (boot_phase_t phase);
+
+#endif
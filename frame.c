@@ -0,0 +1,119 @@
+/** @file frame.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief 5x7 framebuffer with fading trails and dirty column flush
+ */
+
+#include "system.h"
+#include "tinygl.h"
+#include "profile.h"
+#include "scan.h"
+#include "frame.h"
+
+#if SCAN_PLANES != 2
+#error "frame_fade counts trail levels down as two bit planes"
+#endif
+
+/* what the game has drawn, the trail under it by bit plane and what the
+   display is showing by bit plane */
+static uint8_t frame_columns[FRAME_WIDTH];
+static uint8_t frame_trails[SCAN_PLANES][FRAME_WIDTH];
+static uint8_t frame_shown[SCAN_PLANES][FRAME_WIDTH];
+static uint8_t frame_flushes;
+
+
+void frame_clear (void)
+{
+    uint8_t col;
+
+    tinygl_clear ();
+    PROFILE_LATENCY_CANCEL ();
+    for (col = 0; col < FRAME_WIDTH; col++) {
+        frame_columns[col] = 0;
+        frame_trails[0][col] = 0;
+        frame_trails[1][col] = 0;
+        frame_shown[0][col] = 0;
+        frame_shown[1][col] = 0;
+    }
+    frame_flushes = 0;
+}
+
+
+void frame_draw_point (tinygl_point_t point, bool value)
+{
+    if (point.x < 0 || point.x >= FRAME_WIDTH || point.y < 0 || point.y >= FRAME_HEIGHT) {
+        return;
+    }
+    if (value) {
+        frame_columns[point.x] |= 1 << point.y;
+    } else {
+        frame_columns[point.x] &= ~(1 << point.y);
+    }
+}
+
+
+void frame_trail (tinygl_point_t point)
+{
+    uint8_t bit;
+
+    if (point.x < 0 || point.x >= FRAME_WIDTH || point.y < 0 || point.y >= FRAME_HEIGHT) {
+        return;
+    }
+    bit = 1 << point.y;
+    frame_columns[point.x] &= ~bit;
+    frame_trails[0][point.x] = (frame_trails[0][point.x] & ~bit) | ((FRAME_TRAIL_LEVEL & 1) ? bit : 0);
+    frame_trails[1][point.x] = (frame_trails[1][point.x] & ~bit) | ((FRAME_TRAIL_LEVEL & 2) ? bit : 0);
+}
+
+
+bool frame_pixel_get (tinygl_point_t point)
+{
+    if (point.x < 0 || point.x >= FRAME_WIDTH || point.y < 0 || point.y >= FRAME_HEIGHT) {
+        return 0;
+    }
+    return (frame_columns[point.x] >> point.y) & 1;
+}
+
+
+/*
+ * Take every pixel of the trail down a level, each column's two bit planes
+ * counted down together.
+ */
+static void frame_fade (void)
+{
+    uint8_t col, low, high;
+
+    for (col = 0; col < FRAME_WIDTH; col++) {
+        low = frame_trails[0][col];
+        high = frame_trails[1][col];
+        frame_trails[0][col] = high & ~low; // 2 becomes 1, 3 becomes 2 and 1 becomes 0
+        frame_trails[1][col] = high & low;
+    }
+}
+
+
+void frame_flush (void)
+{
+    uint8_t col, row, low, high, changed;
+
+    frame_flushes++;
+    if (frame_flushes == FRAME_FADE_FLUSHES) {
+        frame_flushes = 0;
+        frame_fade ();
+    }
+    for (col = 0; col < FRAME_WIDTH; col++) {
+        low = frame_columns[col] | frame_trails[0][col]; // what is drawn shows full over the trail
+        high = frame_columns[col] | frame_trails[1][col];
+        changed = (low ^ frame_shown[0][col]) | (high ^ frame_shown[1][col]);
+        if (!changed) {
+            continue;
+        }
+        for (row = 0; row < FRAME_HEIGHT; row++) {
+            if ((changed >> row) & 1) {
+                scan_pixel_level (col, row, ((low >> row) & 1) | ((high >> row) & 1) << 1);
+            }
+        }
+        frame_shown[0][col] = low;
+        frame_shown[1][col] = high;
+    }
+}
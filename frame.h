@@ -0,0 +1,62 @@
+/** @file frame.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief 5x7 framebuffer for the game screen, one byte per column with bit
+ *  n for row n. Game objects draw into it as often as they like during a
+ *  tick and frame_flush pushes only the columns that changed to the display
+ *  once per tick, so an erase and redraw of the same pixel never reaches
+ *  the LEDs.
+ *
+ *  Under what is drawn lies a trail: a pixel turned off with frame_trail
+ *  drops to FRAME_TRAIL_LEVEL and fades a level every FRAME_FADE_FLUSHES
+ *  flushes, so things that move leave a dim tail behind them. The trail's
+ *  levels are kept as the scan's bit planes, one byte per column each, and
+ *  fade a column at a time with a few logic operations.
+ */
+
+#ifndef FRAME_H
+#define FRAME_H
+
+#include "system.h"
+#include "tinygl.h"
+
+#define FRAME_WIDTH TINYGL_WIDTH
+#define FRAME_HEIGHT TINYGL_HEIGHT
+
+#define FRAME_TRAIL_LEVEL 2  // brightness a pixel drops to as something leaves it
+#define FRAME_FADE_FLUSHES 4 // flushes between fades, 40 ms at the game's display rate
+
+/*
+ * Blank the frame and the display, also stops any tinygl text so call it
+ * when a game screen starts.
+ */
+void frame_clear (void);
+
+/*
+ * Set or clear one pixel, points off the screen are ignored.
+ * @param point - pixel to change
+ * @param value - 1 to light it, 0 to turn it off
+ */
+void frame_draw_point (tinygl_point_t point, bool value);
+
+/*
+ * Turn a pixel off leaving a dim copy of it that fades out, points off the
+ * screen are ignored.
+ * @param point - pixel something has just moved off
+ */
+void frame_trail (tinygl_point_t point);
+
+/*
+ * Read back one pixel of the frame, trails read as off.
+ * @param point - pixel to read
+ */
+bool frame_pixel_get (tinygl_point_t point);
+
+/*
+ * Copy the columns that changed since the last flush to the display's back
+ * frame. Call it just before tinygl_update, which hands the frame to the
+ * scan.
+ */
+void frame_flush (void);
+
+#endif
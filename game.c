@@ -8,33 +8,138 @@
 #include "movement.h"
 #include "boing.h"
 #include "ir_uart.h"
+#include "ir_rx.h"
+#include "message.h"
 #include "../fonts/font5x7_1.h"
 #include "ball.h"
+#include "frame.h"
 #include "led.h"
+#include "profile.h"
+#include "prng.h"
+#include "sched.h"
+#include "nav_queue.h"
+#include "lockstep.h"
+#include "record.h"
+#include "ai.h"
+#include "ring.h"
+#include "round.h"
+#include "boot.h"
+#include "level.h"
+#include "stack.h"
+#include "state.h"
+#include "text.h"
 #include <stdlib.h>
+#include <string.h>
+#include <avr/pgmspace.h>
 
 
-#define BALL_SPEED 8   // [dots/second]
 #define BALL_THROWS 12
-#define LOOP_RATE 300  // [Hz]
+#define DISPLAY_RATE 100  // [Hz] frames handed to the scan interrupt, no faster than the LEDs refresh
+#define INPUT_RATE 100    // [Hz] presses wait in the queue with their times, so none are lost between looks
+#define LINK_RATE 100     // [Hz] IR service, well ahead of the 32 byte receive ring at 240 bytes/s
 #define NUM_ROWS 7
 #define NUM_COLUMNS 5
 #define TEXT_SPEED 15
-#define NUM_SHOTS 12
+#define TEXT_SCROLL_TICKS(length) (((length) + 1) * 10 * INPUT_RATE / TEXT_SPEED) // input ticks to scroll text across once, TEXT_SPEED is characters per 10 s
+#define TEXT_SIZE 9 // [chars] longest fixed text, "CONTINUE", and its terminator
+#define DIAG_TEXT_SIZE 236 // [chars] boot times, free stack and both boards' link stats at their longest
+#define DIAG_BUTTON NAVSWITCH_EAST // held at power on for the diagnostics screen
 
 
-#define BALL_SPEED_TICKS (LOOP_RATE)/(BALL_SPEED)
+// a ball leaves the shooter's screen one ball step after its last move there
+#define BALL_PATH_HANDOFF_STEPS (BALL_PATH_SHOOTER_MOVES + 1)
+
+#define HANDOFF_SIZE 4 // [bytes] row, speed and the tick the ball left on
+#define PATH_HANDOFF_SIZE (BALL_PATH_SIZE + 3) // [bytes] path, speed and the tick the ball was fired on
+#define ROLE_SIZE 5 // [bytes] role, level, timer count of the push and whether it answers a claim
+
+/*
+ * Role selection screen state, shared with its task
+ */
+typedef struct role_select_s
+{
+    int8_t i;   // option showing
+    char role;  // role taken
+    bool done;
+    bool claimed;       // pushed and sent the role, waiting to hear the other board
+    timer_tick_t claim; // timer count of the push
+    bool answer_due;    // given way to the other's claim, the answer goes once the window has room
+} RoleSelect;
+
+/*
+ * Continue screen state, shared with its task
+ */
+typedef struct ready_wait_s
+{
+    bool ready_due;  // pushed, the ready goes once the window has room
+    bool ready_sent;
+    bool ready_received;
+    bool done;
+#ifdef RING
+    uint16_t hold; // input ticks the result stays up for before the next match can take it away
+#endif
+#ifdef PROFILE
+    bool report;   // the end screen, north steps through the profiler's report
+    uint8_t piece; // 0 for the result, then each piece of the report
+#endif
+} ReadyWait;
 
 /*
- * Player structure
- * role: stores if the player is playing as catcher or shooter
- * balls_caught: stores the number of balls caugth by the player
- * */
-typedef struct player_s
+ * Diagnostics screen state, shared with its task
+ */
+typedef struct diagnostics_s
 {
-  char role;
-  uint8_t balls_caught;
-} Player;
+    message_stats_t remote;    // the other board's, once it has sent them
+    bool have_remote;
+    uint16_t round_trip;       // round trip the text was last built with
+    bool done;                 // never set, the screen lasts until reset
+    bool stats_due;            // pushed, the stats go once the window has room
+    char text[DIAG_TEXT_SIZE];
+} Diagnostics;
+
+static sched_task_t* ball_task; // lined up with the shared tick clock whenever it moves
+
+/* fixed text stays in flash, tinygl is given a copy in text_buffer */
+static const char role_options[2] PROGMEM = {'C', 'S'}; // roles as characters
+#ifdef RING
+#define ROLE_FIRST 1 // role shown first, a ring board can only take the token
+#else
+#define ROLE_FIRST 0
+#endif
+static const char text_continue[] PROGMEM = "CONTINUE";
+static const char text_win[] PROGMEM = "WINNER";
+static const char text_lose[] PROGMEM = "LOSER";
+static const char text_tie[] PROGMEM = "TIE";
+#ifdef RING
+static const char text_wait[] PROGMEM = "WAIT";
+#endif
+static const char boot_labels[BOOT_NUM_PHASES][8] PROGMEM = {"CLK ", " DISP ", " FRAME ", " NAV ", " UP ", " IR "};
+static char text_buffer[TEXT_SIZE]; // tinygl scrolls from the string it was given, so this outlives the call
+
+#ifdef AI
+#define AI_REACTION_TICKS (AI_REACTION_MS * INPUT_RATE / 1000) // input ticks between computer paddle moves
+#endif
+
+#ifdef MULTI_BALL
+// a tick's handoffs go in one frame, its tick, round and count then a row and speed for each
+#define BALLS_HANDOFF_SIZE(count) (4 + 2 * (count))
+#if BALLS_HANDOFF_SIZE (BALL_POOL_SIZE) > MESSAGE_PAYLOAD_MAX
+#error "a whole pool of handoffs does not fit in one message"
+#endif
+#endif
+
+/*
+ * Copies fixed text out of flash into the text buffer.
+ * @param text - string in program memory, at most TEXT_SIZE - 1 characters
+ * returns text_buffer
+ */
+static const char* textFromFlash (const char* text)
+{
+    strncpy_P (text_buffer, text, TEXT_SIZE);
+    text_buffer[TEXT_SIZE - 1] = '\0'; // cut short rather than run on
+    return text_buffer;
+}
+
 
 /*
  * Sets the text graph on the LED matrix.
@@ -42,418 +147,1391 @@ typedef struct player_s
  */
 static void displayCharacter (char character)
 {
-    char buffer[2];
-    buffer[0] = character;
-    buffer[1] = '\0';
-    tinygl_text (buffer);
+    text_buffer[0] = character;
+    text_buffer[1] = '\0';
+    tinygl_text (text_buffer);
 }
 
 
 /*
- * Clears the funkits buffer to ensure there is
- * nothing left after we have recieve what we need to
-*/
-static void clearBuffer(void)
+ * Moves the round on, an event with no move from the round's state is counted and
+ * changes nothing
+ * @param game - game_state_t
+ * @param event - what happened
+ */
+static void roundEvent(game_state_t* game, round_event_t event)
 {
-  while (ir_uart_read_ready_p ()) {
-    ir_uart_getc(); // get the next char in the buffer and do nothing with it
-  }
+    game->round = round_event (game->round, event);
 }
 
 
 /*
- * Decides what role the second player will play depending on what
- * the first player choose
-*/
+ * Display task, pushes what was drawn since last time and hands the frame to the scan interrupt
+ * @param data - unused
+ */
+static void displayTask(void* data)
+{
+    (void) data;
+    frame_flush ();
+    tinygl_update ();
+    PROFILE_PHASE_END (PROFILE_DISPLAY);
+}
 
-static char getChar(void)
+
+/*
+ * Runs a screen that waits on the player, its task scans the navswitch and reads
+ * messages while the display task keeps the text moving
+ * @param screen_task - task for the screen, sets done to leave
+ * @param data - handed to screen_task
+ * @param done - set by screen_task
+ */
+static void runScreen(sched_func_t screen_task, void* data, const bool* done)
 {
-    tinygl_clear(); //clear screen
-    char character = ir_uart_getc();
-    if (character == 'C') {
-        return 'S';   // if a player chooses C, then the other player should become the shooter
-    } else if (character == 'S') {
-        return 'C';
+    sched_task_t tasks[] = {
+        SCHED_TASK (screen_task, data, INPUT_RATE),
+        SCHED_TASK (displayTask, NULL, DISPLAY_RATE),
+    };
+    sched_run (tasks, 2, done);
+    lockstep_resume (); // the ball ticks stood still while the screen was up
+}
+
+
+#ifdef PROFILE
+/*
+ * Steps the end screen on to the next piece of the profiler's report on a
+ * press north, after the last one it comes back round to the result.
+ * @param wait - the screen's state
+ * @param button - the button pressed
+ */
+static void stepReport(ReadyWait* wait, uint8_t button)
+{
+    if (!wait->report || button != NAVSWITCH_NORTH) {
+        return;
     }
-    return 'Z';
+    wait->piece = (wait->piece + 1) % (PROFILE_NUM_PIECES + 1);
+    tinygl_text (wait->piece ? profile_report (wait->piece - 1) : text_buffer); // the result is still in text_buffer
 }
+#endif
 
 
 /*
- * Displays options to the player to select the role they would like to play, first to select a role
- * gets the role. This is sent over IR and player is the complement option of whats selected first.
+ * Steps the level on a press east or west and shows its number, 1 the easiest
+ * @param button - the button pressed
  */
-static char choosePlayers(void)
+static void chooseLevel(uint8_t button)
 {
-    tinygl_font_set (&font5x7_1);
-    tinygl_text_speed_set (TEXT_SPEED);
-    char options[2] = {'C', 'S'}; // roles as characters
-    char current_character = options[0];
-    int8_t i = 0;
-    displayCharacter(options[0]); //displays the character to the ledmat
-    char test;
-    while (1) {
-        pacer_wait ();
-        navswitch_update ();
-        tinygl_update ();
-        if (ir_uart_read_ready_p ()) {
-            test = getChar();
-            if (test != 'Z') { //checks if we are actually getting a valid character so we dont get interference
-                return test;
-            }
+    uint8_t level = level_get ();
+    if (button == NAVSWITCH_EAST && level < LEVEL_NUM_LEVELS - 1) {
+        level++;
+    } else if (button == NAVSWITCH_WEST && level > 0) {
+        level--;
+    } else if (button != NAVSWITCH_EAST && button != NAVSWITCH_WEST) {
+        return;
+    }
+    level_set (level);
+    displayCharacter('1' + level);
+}
+
+
+#ifndef RING
+/*
+ * Sends this board's role and level, as a claim or as the answer to the other board's
+ * @param select - RoleSelect
+ * @param answer - 1 if this board has given way to the other's claim
+ * returns 0 if the window had no room for it
+ */
+static bool sendRole(const RoleSelect* select, bool answer)
+{
+    uint8_t payload[ROLE_SIZE];
+    payload[0] = select->role;
+    payload[1] = level_get ();
+    payload[2] = select->claim & 0xFF;
+    payload[3] = select->claim >> 8;
+    payload[4] = answer;
+    return message_send (MESSAGE_ROLE, payload, ROLE_SIZE);
+}
+
+
+/*
+ * Decides between two claims made before either board heard the other's, the lower
+ * timer count wins as with ring tokens, then the lower role and level, so both boards
+ * decide the same way
+ * @param select - RoleSelect, with this board's claim
+ * @param payload - the other board's claim
+ * returns 1 if the other board's claim wins, 0 if this board's does and -1 if they are the same
+ */
+static int8_t claimBeaten(const RoleSelect* select, const uint8_t* payload)
+{
+    timer_tick_t claim = payload[2] | (timer_tick_t) payload[3] << 8;
+    if (claim != select->claim) {
+        return claim < select->claim;
+    }
+    if (payload[0] != select->role) {
+        return payload[0] < select->role;
+    }
+    if (payload[1] != level_get ()) {
+        return payload[1] < level_get ();
+    }
+    return -1;
+}
+
+
+/*
+ * Role selection task, first to push gets the role they are showing and the other
+ * player is told over IR with the level to play at. If both push before either hears
+ * the other, one claim beats the other. A board only leaves the screen once the other
+ * has answered its claim or it has given way to the other's, so both cannot keep
+ * the role they picked.
+ * @param data - RoleSelect
+ */
+static void rolesTask(void* data)
+{
+    RoleSelect* select = data;
+    uint8_t payload[MESSAGE_PAYLOAD_MAX];
+    nav_event_t event;
+    int8_t beaten = 1;
+    nav_queue_poll ();
+    message_service ();
+    if (message_take (MESSAGE_ROLE, payload)) {
+        if (!payload[4] && select->claimed) {
+            beaten = claimBeaten(select, payload);
         }
-        if (navswitch_push_event_p(NAVSWITCH_PUSH)) {
-            tinygl_clear();
-            clearBuffer();
-            ir_uart_putc(current_character); //send the selected option to the other funkit
-            clearBuffer();
-            return current_character;
+        if (beaten < 0) {
+            select->claimed = 0; // the same push on both boards, the players push again
+        } else if (beaten) {
+            select->role = payload[0] == 'C' ? 'S' : 'C'; // if a player chooses C, then the other player should become the shooter
+            level_set (payload[1]); // the first to push picked the level too
+            select->answer_due = !payload[4]; // tell the other board it has the role it claimed
+            select->done = payload[4];
         }
-        if (navswitch_push_event_p(NAVSWITCH_NORTH)) {
-            i++;
-            if (i == 2){ //ensure wrap arounds
-                i = 0;
-            }
-            current_character =  options[i];
-            displayCharacter(current_character);
+    }
+    if (select->answer_due && sendRole(select, 1)) {
+        select->answer_due = 0;
+        select->done = 1;
+    }
+    while (!select->done && nav_queue_get (&event)) {
+        if (select->claimed || select->answer_due) {
+            continue; // waiting for the other board to answer, or to answer it
         }
-        if (navswitch_push_event_p(NAVSWITCH_SOUTH)) {
-            i--;
-            if (i < 0) {//ensure wrap arounds
-                i = 1;
+        if (event.button == NAVSWITCH_PUSH) {
+            select->role = pgm_read_byte (&role_options[select->i]);
+            select->claim = event.time;
+            select->claimed = sendRole(select, 0); //send the selected option and level to the other funkit, a full window drops the push
+        } else if (event.button == NAVSWITCH_NORTH) {
+            select->i++;
+            if (select->i == 2){ //ensure wrap arounds
+                select->i = 0;
+            }
+            displayCharacter(pgm_read_byte (&role_options[select->i]));
+        } else if (event.button == NAVSWITCH_SOUTH) {
+            select->i--;
+            if (select->i < 0) {//ensure wrap arounds
+                select->i = 1;
             }
-            current_character =  options[i];
-            displayCharacter(current_character);
+            displayCharacter(pgm_read_byte (&role_options[select->i]));
+        } else {
+            chooseLevel(event.button);
+        }
+    }
+    PROFILE_PHASE_END (PROFILE_INPUT);
+}
+#endif
+
+
+/*
+ * Forgets any ball still on its way from a round that is over, in a ring one the
+ * board upstream sent before it took the token, from a round it shot or watched
+ * whose catcher was not this board. Handoffs this board sent that are still waiting
+ * to be acknowledged are taken back too, so they are not sent again in full.
+ */
+static void forgetBalls(void)
+{
+    message_discard (MESSAGE_BALL);
+    message_discard (MESSAGE_BALLS);
+    message_discard (MESSAGE_PATH);
+    message_withdraw (MESSAGE_BALL);
+    message_withdraw (MESSAGE_BALLS);
+    message_withdraw (MESSAGE_PATH);
+}
+
+
+#ifdef RING
+/*
+ * Start screen task for a ring, the first board to push takes the token and shoots,
+ * the board downstream of it catches and the rest watch
+ * @param data - RoleSelect
+ */
+static void ringStartTask(void* data)
+{
+    RoleSelect* select = data;
+    nav_event_t event;
+    uint8_t token;
+    nav_queue_poll ();
+    message_service ();
+    ring_flush ();
+    token = ring_token_take ();
+    if (token != RING_TOKEN_NONE) {
+        select->role = token == RING_TOKEN_CATCH ? 'C' : 'W';
+        select->done = 1;
+        forgetBalls();
+    }
+    while (!select->done && nav_queue_get (&event)) {
+        if (event.button == NAVSWITCH_PUSH) {
+            select->role = 'S';
+            ring_token_send (0);
+            select->done = 1;
+        } else {
+            chooseLevel(event.button);
+        }
+    }
+    PROFILE_PHASE_END (PROFILE_INPUT);
+}
+
+
+/*
+ * Push screen task for a ring, done once this player pushes, or once another board has
+ * started the next match and the hold is over, the token is left for the start screen
+ * to take
+ * @param data - ReadyWait
+ */
+static void ringPushTask(void* data)
+{
+    ReadyWait* wait = data;
+    nav_event_t event;
+    nav_queue_poll ();
+    message_service ();
+    ring_flush (); // the last table may not have gone on yet
+    while (nav_queue_get (&event)) {
+        if (event.button == NAVSWITCH_PUSH) {
+            wait->ready_sent = 1; // nothing is sent, no one upstream would hear it
         }
+#ifdef PROFILE
+        stepReport(wait, event.button);
+#endif
+    }
+    if (wait->hold) {
+        wait->hold--;
     }
+    wait->done = wait->ready_sent || (!wait->hold && message_waiting (MESSAGE_TOKEN, NULL));
+    PROFILE_PHASE_END (PROFILE_INPUT);
 }
+#endif
+
+
+/*
+ * Displays options to the player to select the role they would like to play, first to select a role
+ * gets the role. This is sent over IR and player is the complement option of whats selected first.
+ * In a ring there is only 'S', to take the token.
+ */
+static char choosePlayers(void)
+{
+#ifdef RING
+    RoleSelect select = {ROLE_FIRST, 'S', 0, 0, 0, 0};
+#else
+    RoleSelect select = {ROLE_FIRST, 'C', 0, 0, 0, 0};
+#endif
+    tinygl_font_set (&font5x7_1);
+    tinygl_text_speed_set (TEXT_SPEED);
+    tinygl_text_mode_set (TINYGL_TEXT_MODE_STEP); // the end screen scrolled before a rematch
+    displayCharacter(pgm_read_byte (&role_options[select.i])); //displays the character to the ledmat
+#ifdef RING
+    ring_reset (); // the last match's token is beaten by any from this one
+    runScreen(ringStartTask, &select, &select.done);
+#else
+    runScreen(rolesTask, &select, &select.done);
+#endif
+    tinygl_clear();
+    return select.role;
+}
+
+
+#ifdef RING
+/*
+ * Shows that this board is waiting while two others play a round of the ring
+ * @param game - game_state_t
+ */
+static void watchRound(game_state_t* game)
+{
+    game->role = 'W';
+    roundEvent(game, ROUND_EVENT_WATCH);
+#ifdef MULTI_BALL
+    ballPoolClear(&game->ball_pool); // the shooter's last throws may have been in the air
+#endif
+    frame_clear();
+    tinygl_font_set (&font5x7_1);
+    tinygl_text_speed_set (TEXT_SPEED);
+    tinygl_text_mode_set (TINYGL_TEXT_MODE_SCROLL);
+    tinygl_text (textFromFlash (text_wait));
+}
+#endif
 
 
 /*
 * Starts the game and sets up the players depending on what role they choose,
 * also initialises the catcher and shooter graphics
-* @param catcher_pos_left - left LED of the catcher paddle
-* @param catcher_pos_right - right LED of the catcher paddle
-* @param shooter_pos - LED of the shooter
-* returns a player object
+* @param game - game_state_t, takes the role and the paddle rows or shooter row
 */
-static Player startGame(tinygl_point_t* catcher_pos_left,
-                tinygl_point_t* catcher_pos_right, tinygl_point_t* shooter_pos)
+static void startGame(game_state_t* game)
 {
-    Player player;
     char current_character = choosePlayers(); //choose who is catcher/shooter on new game
+    game->balls_caught = 0;
     if (current_character == 'C') {
-        player.role = 'C'; //set role and number of balls caught
-        player.balls_caught = 0;
-        catcher_init(catcher_pos_left, catcher_pos_right);
+        game->role = 'C'; //set role
+        catcher_init(&game->paddle, level_paddle_width());
+        roundEvent(game, ROUND_EVENT_CATCH);
+#ifdef RING
+    } else if (current_character == 'W') {
+        watchRound(game);
+#endif
     } else {
-        player.role = 'S';
-        player.balls_caught = 0;
-        shooter_init(shooter_pos);
+        game->role = 'S';
+        shooter_init(&game->shooter_row);
+        roundEvent(game, ROUND_EVENT_SHOOT);
+#ifdef RING
+        game->has_shot = 1;
+#endif
+    }
+}
+
 
+#ifndef RING
+/*
+ * Continue screen task, done once this player has pushed and the other player's
+ * ready has arrived
+ * @param data - ReadyWait
+ */
+static void readyTask(void* data)
+{
+    ReadyWait* wait = data;
+    nav_event_t event;
+    nav_queue_poll ();
+    message_service ();
+    if (message_take (MESSAGE_READY, NULL)) { // checks if the other player is ready
+        wait->ready_received = 1;
     }
-    tinygl_update ();
-    return player;
+    while (nav_queue_get (&event)) { // presses while waiting are dropped, not saved for the next round
+        if (event.button == NAVSWITCH_PUSH) {
+            wait->ready_due = 1;
+        }
+#ifdef PROFILE
+        stepReport(wait, event.button);
+#endif
+    }
+    if (wait->ready_due && !wait->ready_sent) {
+        wait->ready_sent = message_send (MESSAGE_READY, NULL, 0); // send a message saying they're ready, again next time if the window is full
+    }
+    wait->done = wait->ready_sent && wait->ready_received; // must have recieved and sent something to continue
+    PROFILE_PHASE_END (PROFILE_INPUT);
 }
+#endif
+
 
 /*
  * Displays 'continue' to the screen after a round is over,
  * will also wait until both players have acknowledged this clicked
- * the nav button in
+ * the nav button in. A ready sent by the other player before this
+ * screen came up is still waiting in its mailbox.
 */
 
 static void showSwitchingScreen(void)
 {
-    int8_t reqs = 0;
-    tinygl_clear();
+    ReadyWait wait = {0};
+    frame_clear(); // a trail left fading would draw over the text
     tinygl_font_set (&font5x7_1);
     tinygl_text_speed_set (TEXT_SPEED);
     tinygl_text_mode_set (TINYGL_TEXT_MODE_SCROLL);
-    tinygl_text ("CONTINUE"); // display to ledmat
-    char transmition;
-    while (1) {
-        pacer_wait ();
-        navswitch_update ();
-        tinygl_update();
-        if (ir_uart_read_ready_p()){ // checks if something has been sent
-            transmition = ir_uart_getc();
-            if (transmition == 'R') { // and whether it is a valid char
-               reqs++;
-            }
-
-        }
-        if (navswitch_push_event_p(NAVSWITCH_PUSH)) {
-            ir_uart_putc('R'); // send a message saying they're ready
-            reqs++;
-        }
-        if (reqs == 2) {// must have recieved and sent something to continue
-            break;
-        }
-    }
+    tinygl_text (textFromFlash (text_continue)); // display to ledmat
+#ifdef RING
+    runScreen(ringPushTask, &wait, &wait.done); // only the new shooter waits, the catcher starts on its token
+#else
+    runScreen(readyTask, &wait, &wait.done);
+#endif
     tinygl_clear(); //clear the screen
 }
 
 
 /*
- * Displays winner or loser to the ledmat
- * @param text - takes text to output to the ledmat
+ * Displays winner or loser to the ledmat, in profiled builds north steps on
+ * to the loop stats and the RAM the stack has never reached.
+ * Returns once both players have pushed for a rematch, the same handshake as the
+ * continue screen.
+ * @param text - takes text in program memory to output to the ledmat
  */
 
-static void displayGameOver(char* text)
+static void displayGameOver(const char* text)
 {
-    tinygl_clear();
+    ReadyWait wait = {0};
+#ifdef RING
+    nav_event_t event;
+#endif
+    frame_clear();
     tinygl_font_set (&font5x7_1);
     tinygl_text_speed_set (TEXT_SPEED);
     tinygl_text_mode_set (TINYGL_TEXT_MODE_SCROLL);
-    tinygl_text (text); // set the text
-    while (1) {
-        pacer_wait ();
-        tinygl_update();
+    tinygl_text (textFromFlash (text)); // set the text
+#ifdef PROFILE
+    wait.report = 1; // the report is only on the LEDs, raw text would land in the other board's frames
+#endif
+#ifdef RING
+    wait.hold = TEXT_SCROLL_TICKS (strlen (text_buffer)); // seen at least once, even if the next match has started
+    nav_queue_poll ();
+    while (nav_queue_get (&event)) {
+        // pressed before the result came up, not an answer to it
     }
+    runScreen(ringPushTask, &wait, &wait.done); // on to the start screen, where a waiting token is taken
+#else
+    runScreen(readyTask, &wait, &wait.done);
+#endif
+    tinygl_clear();
 }
 
 
 /*
  * Checks the other players score against its own to decide the outcome
  * of the game.
- * @param player - player object
- * @param other_player_score - unsigned int which contains the other players score
+ * @param game - game_state_t, with both players' scores
  */
 
-static void displayEndScreen(Player* player, uint8_t other_player_score)
+static void displayEndScreen(const game_state_t* game)
 {
-    //text of the outcome of the game
-    char win[] = {'W', 'I', 'N', 'N', 'E', 'R', '\0'};
-    char lose[] = {'L', 'O', 'S', 'E', 'R', '\0'};
-    char tie[] = {'T', 'I', 'E', '\0'};
-    tinygl_clear();
-    clearBuffer();
-    tinygl_font_set (&font5x7_1);
-    while(1) {
-        pacer_wait();
-        tinygl_update();
-        if (player->balls_caught > other_player_score) {
-            displayGameOver(win); // display winner message to ledmat if your score is greater than the other players
-        } else if (player->balls_caught < other_player_score) {
-            displayGameOver(lose);
-        } else {
-            displayGameOver(tie);
-        }
+#ifdef RING
+    int8_t result = ring_result (&game->table, game->balls_caught); // against the best round in the ring
+    if (result > 0) {
+        displayGameOver(text_win);
+    } else if (result < 0) {
+        displayGameOver(text_lose);
+    } else {
+        displayGameOver(text_tie);
+    }
+#else
+    if (game->balls_caught > game->other_player_score) {
+        displayGameOver(text_win); // display winner message to ledmat if your score is greater than the other players
+    } else if (game->balls_caught < game->other_player_score) {
+        displayGameOver(text_lose);
+    } else {
+        displayGameOver(text_tie);
     }
+#endif
 }
 
 /*
  * At the end of the round the players roles are switched and draws graphics for each role
- *@param player - pointer to player object
- *@param catcher_pos_left -  pointer to left LED of the catcher paddle
- *@param catcher_pos_right -  pointer to right LED of the catcher paddle
- *@param shooter_pos -  pointer to LED of the shooter
+ *@param game - game_state_t
 */
-static void endTurn(Player* player, tinygl_point_t* catcher_pos_left,
-                tinygl_point_t* catcher_pos_right, tinygl_point_t* shooter_pos)
+static void endTurn(game_state_t* game)
 {
     showSwitchingScreen();
-    if (player->role == 'C') {
-        player->role = 'S'; // switch roles
-        shooter_init(shooter_pos); // init the shooter graphics
+#ifdef MULTI_BALL
+    ballPoolClear(&game->ball_pool); // balls still in the air when the round ended
+#endif
+    if (game->role == 'C') {
+        game->role = 'S'; // switch roles
+        shooter_init(&game->shooter_row); // init the shooter graphics
     } else {
-        player->role = 'C';
-        catcher_init(catcher_pos_left, catcher_pos_right);  // init the catcher graphics
+        game->role = 'C';
+        catcher_init(&game->paddle, level_paddle_width());  // init the catcher graphics
     }
 }
 
 
+#ifndef MULTI_BALL
 /*
  * Decides where the ball will be recived on the next funkit
  * i.e. what column will the ball be
  * @param ball_ptr - pointer to the recieved ball
+ * @param row - row the ball left the shooter's screen on
 */
 
-static void recieveBall(boing_state_t* ball_ptr)
+static void recieveBall(boing_state_t* ball_ptr, uint8_t row)
 {
     (*ball_ptr).pos.x = 0;
-    (*ball_ptr).pos.y = NUM_ROWS - 1 - ir_uart_getc(); // set the row the ball is in using the row it left from
+    (*ball_ptr).pos.y = NUM_ROWS - 1 - row; // set the row the ball is in using the row it left from
     ball_ptr->dir = DIR_E; // change the direction of the ball
-    tinygl_draw_point (ball_ptr->pos, 1); // draw it
+    frame_draw_point (ball_ptr->pos, 1); // draw it
+}
+#endif
+
+
+/*
+ * Stamps a handoff message with a shared tick
+ * @param payload - the two bytes to fill
+ * @param tick - tick the ball set off on
+*/
+static void putTick(uint8_t* payload, lockstep_tick_t tick)
+{
+    payload[0] = tick & 0xFF;
+    payload[1] = tick >> 8;
+}
+
+
+/*
+ * Reads the shared tick a handoff message was stamped with
+ * @param payload - the two bytes from putTick
+*/
+static lockstep_tick_t getTick(const uint8_t* payload)
+{
+    return payload[0] | (lockstep_tick_t) payload[1] << 8;
+}
+
+
+/*
+ * Reseeds the wind gusts, logged so a recorded match can be checked on replay
+ * @param seed - the seed tick
+*/
+static void seedGusts(uint8_t seed)
+{
+    prng_seed(seed);
+    RECORD_SEED_USED (seed);
+}
+
+#ifndef RING
+/*
+* Sends the catchers score to the other player after the round is over, along with
+* the round it ends for anyone reading the IR log
+* @param game - game_state_t
+* returns 0 if the window had no room for it
+*/
+static bool sendScore(game_state_t* game)
+{
+    uint8_t payload[2];
+    payload[0] = game->balls_caught;
+    payload[1] = game->turns + 1;
+    if (!message_send (MESSAGE_SCORE, payload, 2)) { // transmit ready for end turn screen
+        return 0;
+    }
+    game->num_balls_received = 0;
+    return 1;
+}
+
+
+/*
+ * Ends the round the same way on both boards, each counts it, shows the continue
+ * screen and swaps roles, then the round starts again or the match is over
+ * @param game - game_state_t, in ROUND_SCORE_SYNC
+ */
+static void switchRound(game_state_t* game)
+{
+    game->turns = game->turns + 1; // keep track of game progress
+    forgetBalls(); // nothing thrown in the round that is over belongs to the next one
+    message_discard (MESSAGE_SCORE); // a ready for the continue screen may already be in, so that stays
+    roundEvent(game, ROUND_EVENT_SWITCH);
+    endTurn(game); // swap players
+    game->num_balls_fired = 0;
+    if (game->role == 'S') {
+        resetBallNextPlayer(&game->ball); // reset the ball position for the next player
+    }
+    if (game->turns == 2) { // both players have had a turn, on to the scores
+        roundEvent(game, ROUND_EVENT_OVER);
+    } else {
+        roundEvent(game, game->role == 'S' ? ROUND_EVENT_SHOOT : ROUND_EVENT_CATCH);
+    }
+}
+#endif
+
+
+
+/*
+ * Appends one board's link stats to the diagnostics text
+ * @param pos - where to write
+ * @param stats - the stats
+ * returns the position after them
+*/
+static char* appendLinkStats(char* pos, const message_stats_t* stats)
+{
+    pos = text_append_P (pos, PSTR ("RX "));
+    pos = text_append_number (pos, stats->received);
+    pos = text_append_P (pos, PSTR (" BAD "));
+    pos = text_append_number (pos, stats->rejected);
+    pos = text_append_P (pos, PSTR (" LOST "));
+    pos = text_append_number (pos, stats->discarded);
+    pos = text_append_P (pos, PSTR (" RPT "));
+    pos = text_append_number (pos, stats->repeats);
+    pos = text_append_P (pos, PSTR (" RSND "));
+    pos = text_append_number (pos, stats->resent);
+    pos = text_append_P (pos, PSTR (" FULL "));
+    pos = text_append_number (pos, stats->unsent);
+    pos = text_append_P (pos, PSTR (" RTT "));
+    if (stats->round_trip == MESSAGE_NO_ROUND_TRIP) {
+        *pos++ = '-';
+    } else {
+        pos = text_append_number (pos, stats->round_trip);
+        pos = text_append_P (pos, PSTR ("MS"));
+    }
+    return pos;
 }
 
+
 /*
-* Sends the catchers score to the other player after the round is over
-* @param player - pointer to a player object
-* @param turns - the number of turns the player has had
-* @param num_balls_received - the number of balls the catcher has recieved on their side
+ * Appends the time each part of the board took to come up, in microseconds from
+ * the timer starting
+ * @param pos - where to write
+ * returns the position after them
 */
-static void sendScore(Player* player, uint8_t* turns, uint8_t* num_balls_received)
+static char* appendBootTimes(char* pos)
 {
-    *turns = *turns + 1; // keep track of game progress
-    ir_uart_putc(player->balls_caught); // transmit ready for end turn screen
-    *num_balls_received = 0;
+    uint8_t phase;
+    uint16_t time;
+    pos = text_append_P (pos, PSTR ("BOOT "));
+    for (phase = 0; phase < BOOT_NUM_PHASES; phase++) {
+        pos = text_append_P (pos, boot_labels[phase]);
+        time = boot_time (phase);
+        if (time == BOOT_NOT_YET) {
+            *pos++ = '-';
+        } else {
+            pos = text_append_number (pos, time);
+        }
+    }
+    return text_append_P (pos, PSTR ("US "));
 }
 
 
+/*
+ * Builds the diagnostics text from this board's boot times, the RAM its stack has
+ * never reached and its stats and the other board's stats, if they have arrived,
+ * and starts it scrolling
+ * @param diag - Diagnostics
+*/
+static void showLinkStats(Diagnostics* diag)
+{
+    message_stats_t local;
+    char* pos;
+    message_stats (&local);
+    diag->round_trip = local.round_trip;
+    pos = appendBootTimes(diag->text);
+    pos = text_append_P (pos, PSTR ("STACK "));
+    pos = text_append_number (pos, stack_unused ());
+    *pos++ = ' ';
+    pos = appendLinkStats(pos, &local);
+    if (diag->have_remote) {
+        pos = text_append_P (pos, PSTR (" THEM "));
+        pos = appendLinkStats(pos, &diag->remote);
+    }
+    *pos = '\0';
+    tinygl_text (diag->text);
+}
+
+
+/*
+ * Diagnostics screen task, a push sends this board's stats to the other board and
+ * pings it again, and the text is rebuilt whenever there is something new to show
+ * @param data - Diagnostics
+*/
+static void diagnosticsTask(void* data)
+{
+    Diagnostics* diag = data;
+    message_stats_t local;
+    uint8_t payload[MESSAGE_PAYLOAD_MAX];
+    nav_event_t event;
+    bool changed = 0;
+    nav_queue_poll ();
+    message_service (); // answers the other board's pings too
+    if (message_take (MESSAGE_STATS, payload)) {
+        message_stats_decode (&diag->remote, payload);
+        diag->have_remote = 1;
+        changed = 1;
+    }
+    while (nav_queue_get (&event)) {
+        if (event.button == NAVSWITCH_PUSH) {
+            diag->stats_due = 1;
+        }
+    }
+    if (diag->stats_due) {
+        message_stats (&local);
+        message_stats_encode (&local, payload);
+        if (message_send (MESSAGE_STATS, payload, MESSAGE_STATS_SIZE)) { // again next time if the window is full
+            diag->stats_due = 0;
+            message_ping ();
+            changed = 1; // this board's counts have moved on since the text was built
+        }
+    }
+    message_stats (&local);
+    if (changed || local.round_trip != diag->round_trip) {
+        showLinkStats(diag);
+    }
+    PROFILE_PHASE_END (PROFILE_INPUT);
+}
+
 
 /*
- * Initialise everything the game needs, pacer, nav, tinygl, ir
+ * Scrolls how long this board took to come up, the stack headroom it has left and the
+ * IR link stats of this board and of the other board once it sends them, to tell a
+ * slow start, interference or misaligned boards from a bug. Lasts until reset.
+*/
+static void showDiagnostics(void)
+{
+    Diagnostics diag = {{0}, 0, 0, 0, 0, {0}};
+    tinygl_font_set (&font5x7_1);
+    tinygl_text_speed_set (TEXT_SPEED);
+    tinygl_text_mode_set (TINYGL_TEXT_MODE_SCROLL);
+    message_ping ();
+    showLinkStats(&diag);
+    runScreen(diagnosticsTask, &diag, &diag.done);
+}
+
+
+/*
+ * Initialise everything the game needs, the display first so the role screen is on
+ * the LEDs before anything else starts. The IR link starts itself when first used.
 */
 static void initUtils(void)
 {
     system_init();
-    pacer_init (LOOP_RATE); //set the loop rates
-    tinygl_init (LOOP_RATE);
+    sched_init();
+    boot_init ();
+    boot_mark (BOOT_CLOCK);
+    tinygl_init (DISPLAY_RATE); // tinygl_update runs in the display task
+    boot_mark (BOOT_DISPLAY);
+    tinygl_font_set (&font5x7_1);
+    tinygl_text_speed_set (TEXT_SPEED);
+    tinygl_text_mode_set (TINYGL_TEXT_MODE_STEP);
+    displayCharacter(pgm_read_byte (&role_options[ROLE_FIRST])); // what choosePlayers shows first
+    tinygl_update ();
+    boot_mark (BOOT_FIRST_FRAME);
+    RECORD_INIT (); // before anything it logs can happen
     navswitch_init();
-    ir_uart_init();
+    nav_queue_init();
+    boot_mark (BOOT_INPUT);
+    message_init();
+    lockstep_init(BALL_TICK_RATE);
+    PROFILE_INIT (DISPLAY_RATE);
+    boot_mark (BOOT_READY);
 }
 
 
+#ifndef AI
 /*
-* Logic for a player who is a catcher and the events that would occur, deals with positioning and catching of balls
-* @param player- pointer to the player
-* @param catcher_pos_left -  pointer to left LED of the catcher paddle
- *@param catcher_pos_right -  pointer to right LED of the catcher paddle
-* @param ticks - pointer to the number of ticks to control the ball speed
-* @param seed_tick - pointer to seed for the random number
-* @param ball - pointer to the ball object
-* @param num_balls_fired - pointer to the number of balls fired, to know when to stop the shooter from shooting anymore balls
-* @param ball_fired - pointer to a bool to decide if the ball has been fired or not
+* Logic for a player who is a catcher moving the paddle, one move per press in the order pressed
+* @param game - game_state_t
 */
-static void catcherPlayer(Player* player, tinygl_point_t* catcher_pos_left, tinygl_point_t* catcher_pos_right,
-             bool* ball_off_screen, uint8_t* ticks, uint8_t* seed_tick, boing_state_t* ball, bool* ball_received, uint8_t* num_balls_received)
+static void catcherPlayer(game_state_t* game)
 {
-
-    tinygl_draw_point(*catcher_pos_left,1); // draw the catcher graphics
-    if (navswitch_push_event_p(NAVSWITCH_SOUTH)) {
-        updatePositionCatcher(catcher_pos_left, catcher_pos_right, 'S'); // move the catcher in the right direction
+    nav_event_t event;
+    drawPositionCatcher(game->paddle); // draw the catcher graphics
+    while (nav_queue_get (&event)) {
+        if (event.button == NAVSWITCH_SOUTH) {
+            updatePositionCatcher(&game->paddle, 'S'); // move the catcher in the right direction
+            PROFILE_LATENCY_START (event.time, NUM_COLUMNS - 1); // time the move until the paddle's column is on the ledmat
+        } else if (event.button == NAVSWITCH_NORTH) {
+            updatePositionCatcher(&game->paddle, 'N');
+            PROFILE_LATENCY_START (event.time, NUM_COLUMNS - 1);
+        }
     }
-    if (navswitch_push_event_p(NAVSWITCH_NORTH)) {
-        updatePositionCatcher(catcher_pos_left, catcher_pos_right, 'N');
+}
+#endif
+
+
+
+/*
+* Takes a ball the shooter has sent, it moves on at the speed the shooter threw it
+* from the tick it left on, so the time it took to get here does not slow it down
+* @param game - game_state_t
+*/
+static void catcherReceive(game_state_t* game)
+{
+    uint8_t payload[MESSAGE_PAYLOAD_MAX];
+#ifdef BALL_PATH
+    if (message_take (MESSAGE_PATH, payload)) { // the shooter has fired and sent the whole flight, no gusts to seed
+        decodeBallPath(payload);
+        game->path_wait_steps = BALL_PATH_HANDOFF_STEPS;
+        ballMotionStart(&game->ball_motion, payload[BALL_PATH_SIZE]);
+        ballMotionSkip(&game->ball_motion, lockstep_elapsed (getTick(&payload[BALL_PATH_SIZE + 1])));
     }
-        if (ir_uart_read_ready_p ()) {
-            srand(*seed_tick); // change seed for the random path
-            recieveBall(ball);
-            *ball_received = 1;
+#elif defined (MULTI_BALL)
+    if (message_take (MESSAGE_BALLS, payload) && payload[2] == game->turns) { // every ball that left the shooter's screen in one tick
+        uint8_t late = lockstep_elapsed (getTick(payload));
+        uint8_t i, slot;
+        seedGusts(game->seed_tick);
+        for (i = 0; i < payload[3]; i++) {
+            boing_state_t entering = boing_init (0, NUM_ROWS - 1 - payload[4 + 2 * i], DIR_E);
+            slot = ballPoolAdd(&game->ball_pool, entering, payload[5 + 2 * i]);
+            if (slot < BALL_POOL_SIZE) { // a full pool drops the ball, the shooter throws another
+                ballMotionSkip(&game->ball_pool.motion[slot], late);
+                roundEvent(game, ROUND_EVENT_ARRIVED);
+            }
         }
-        if (*ball_received) {
-            *ticks = *ticks + 1;
-            if (*ticks >= BALL_SPEED_TICKS) { // keeps the ball speed consistent
-                if (*ball_off_screen){
-                    tinygl_draw_point (ball->pos, 0);
-                    updatePositionCatcher(catcher_pos_left, catcher_pos_right, 'X'); // reset the catcher position
-                    (*ball).pos.x = 2;
-                    *ball_off_screen = 0;
-                    *ball_received = 0;
-                } else {
-                    tinygl_draw_point (ball->pos, 0);
-                    updateFiredBallCatcher(ball); //update the balls path
-                    tinygl_draw_point(ball->pos, 1);
-                    updatePositionCatcher(catcher_pos_left, catcher_pos_right, 'X');
-                    if ((*ball).pos.x == (NUM_COLUMNS - 1)) { // if the ball is in the last column (could not be a collision)
-                        *num_balls_received = *num_balls_received + 1;
-                        if ((catcher_pos_left->y == (*ball).pos.y || catcher_pos_right->y == (*ball).pos.y) && catcher_pos_left->x == (*ball).pos.x) { // collision between paddle and ball
-                            player->balls_caught += 1;
-                            }
-                        *ball_off_screen = 1;
+    }
+#else
+    if (message_take (MESSAGE_BALL, payload)) {
+        seedGusts(game->seed_tick); // change seed for the random path
+        recieveBall(&game->ball, payload[0]);
+        roundEvent(game, ROUND_EVENT_ARRIVED);
+        ballMotionStart(&game->ball_motion, payload[1]);
+        ballMotionSkip(&game->ball_motion, lockstep_elapsed (getTick(&payload[2])));
+    }
+#endif
+}
+
+
+
+#ifndef MULTI_BALL
+/*
+* One tick of the ball across the catcher's screen, steps it once it reaches the next dot
+* and deals with catching of balls
+* @param game - game_state_t
+*/
+static void catcherBall(game_state_t* game)
+{
+    boing_state_t* ball = &game->ball;
+    if (!ballMotionAdvance(&game->ball_motion)) { // not at the next dot yet
+        return;
+    }
+#ifdef BALL_PATH
+    if (game->path_wait_steps && --game->path_wait_steps == 0) { // the ball reaches our screen now
+        recieveBall(ball, ballPathExitRow());
+        enterBallPath(ball);
+        roundEvent(game, ROUND_EVENT_ARRIVED);
+        return;
+    }
+#endif
+    if (game->round == ROUND_CATCHING) {
+        if ((*ball).pos.x == (NUM_COLUMNS - 1)) { // it has been past the paddle's column for a step
+            frame_draw_point (ball->pos, 0);
+            updatePositionCatcher(&game->paddle, 'X'); // reset the catcher position
+            (*ball).pos.x = 2;
+            roundEvent(game, ROUND_EVENT_GONE);
+        } else {
+            frame_draw_point (ball->pos, 0);
+            updateFiredBallCatcher(ball); //update the balls path
+            frame_draw_point(ball->pos, 1);
+            updatePositionCatcher(&game->paddle, 'X');
+            if ((*ball).pos.x == (NUM_COLUMNS - 1)) { // if the ball is in the last column (could not be a collision)
+                game->num_balls_received = game->num_balls_received + 1;
+                if (catcherCovers(game->paddle, (*ball).pos.y)) { // collision between paddle and ball
+                    game->balls_caught += 1;
                     }
-                }
-            *ticks = 0;
+            }
         }
     }
 }
+#endif
 
 
 
+#ifdef MULTI_BALL
 /*
- * Logic for a player who is a shooter and the events that would occur, deals with positioning and
- * firing of the ball
- * @param shooter_pos - pointer to the shooter LED, so it can be updated
- * @param ticks - pointer to the number of ticks to control the ball speed
- * @param seed_tick - pointer to seed for the random number
- * @param ball - pointer to the ball object
- * @param num_balls_fired - pointer to the number of balls fired, to know when to stop the shooter from shooting anymore balls
- * @param ball_fired - pointer to a bool to decide if the ball has been fired or not
+* One tick of every ball on the catcher's screen, each one that reaches the last column is
+* checked against the paddle
+* @param game - game_state_t
 */
-static void shooterPlayer(tinygl_point_t* shooter_pos, uint8_t* ticks, uint8_t* seed_tick, boing_state_t* ball, uint8_t* num_balls_fired, bool* ball_fired)
-{
-
-    setBallPositionOnShooter(ball, shooter_pos->y, *ball_fired); // sets the ball position when the ball isnt fired
-    if (navswitch_push_event_p(NAVSWITCH_SOUTH)) { // controls the movement of the shooter
-        updatePositionShooter(shooter_pos, 'S');
-        setBallPositionOnShooter(ball, shooter_pos->y, *ball_fired);
-    }
-    if (navswitch_push_event_p(NAVSWITCH_NORTH)) {
-        srand(*seed_tick); // randomise the ball trajectory by setting the seed as often as possible
-        updatePositionShooter(shooter_pos, 'N');
-        setBallPositionOnShooter(ball, shooter_pos->y, *ball_fired);
-    }
-    if (navswitch_push_event_p(NAVSWITCH_PUSH) && !*ball_fired) { // fire the ball and ensure that players can't spam balls
-        *ball_fired = 1;
-        *num_balls_fired = *num_balls_fired + 1;
-        updateFiredBallShooter(ball); //  update the balls path
-    }
-    if (*ball_fired) {
-        *ticks = *ticks + 1;
-        if (*ticks == BALL_SPEED_TICKS) { // controls the ball speed
-            *ticks = 0;
-            if ((*ball).pos.x != 0){
-                updateFiredBallShooter(ball);
+static void catcherBalls(game_state_t* game)
+{
+    uint8_t arrived = ballPoolAdvanceCatcher(&game->ball_pool);
+    uint8_t slot;
+    for (slot = 0; arrived; slot++, arrived >>= 1) {
+        if (arrived & 1) {
+            game->num_balls_received = game->num_balls_received + 1;
+            if (catcherCovers(game->paddle, game->ball_pool.ball[slot].pos.y)) { // the paddle is in the last column too
+                game->balls_caught += 1;
             }
-            else if ((*ball).pos.x == 0) { // ball is at end of the ledmat, ready to be sent to the next fun kit
-                tinygl_draw_point (ball->pos, 0); // hide the ball
-                (*ball).pos.x = NUM_COLUMNS - 2;
-                (*ball).pos.y = shooter_pos->y;
-                *ball_fired = 0;
-                clearBuffer();
-                ir_uart_putc((*ball).pos.y); // send the row number of the ball when it hits the last column
+        }
+    }
+    if (!game->ball_pool.live && game->round == ROUND_CATCHING) {
+        roundEvent(game, ROUND_EVENT_GONE);
+    }
+    updatePositionCatcher(&game->paddle, 'X'); // a ball leaving the paddle's column blanks its dot
+}
+#endif
+
+
+
+/*
+ * Logic for a player who is a shooter, deals with positioning and firing of the ball
+ * @param game - game_state_t
+*/
+static void shooterPlayer(game_state_t* game)
+{
+
+    nav_event_t event;
+    boing_state_t* ball = &game->ball;
+    setBallPositionOnShooter(ball, game->shooter_row, game->round != ROUND_AIM); // sets the ball position when the ball isnt fired
+    while (nav_queue_get (&event)) {
+        if (event.button == NAVSWITCH_SOUTH) { // controls the movement of the shooter
+            updatePositionShooter(&game->shooter_row, 'S');
+            setBallPositionOnShooter(ball, game->shooter_row, game->round != ROUND_AIM);
+        }
+        if (event.button == NAVSWITCH_NORTH) {
+            seedGusts(game->seed_tick); // randomise the ball trajectory by setting the seed as often as possible
+            updatePositionShooter(&game->shooter_row, 'N');
+            setBallPositionOnShooter(ball, game->shooter_row, game->round != ROUND_AIM);
+        }
+        if (event.button == NAVSWITCH_PUSH && game->round == ROUND_AIM) { // fire the ball and ensure that players can't spam balls
+            game->num_balls_fired = game->num_balls_fired + 1;
+            roundEvent(game, ROUND_EVENT_FIRE);
+#ifdef MULTI_BALL
+            uint8_t slot = ballPoolAdd(&game->ball_pool, *ball, ballThrowSpeed(game->num_balls_fired)); // throw a copy, the next ball loads in its place
+            updateFiredBallShooter(&game->ball_pool.ball[slot]);
+            if (game->ball_pool.live != (1 << BALL_POOL_SIZE) - 1) { // nothing to load until a ball is handed over
+                roundEvent(game, ROUND_EVENT_LOADED);
             }
+#else
+            ballMotionStart(&game->ball_motion, ballThrowSpeed(game->num_balls_fired)); // later throws go faster
+#ifdef BALL_PATH
+            uint8_t path[PATH_HANDOFF_SIZE];
+            planBallPath(ball); // decide the whole flight now and send it to the catcher
+            encodeBallPath(path);
+            path[BALL_PATH_SIZE] = game->ball_motion.speed;
+            putTick(&path[BALL_PATH_SIZE + 1], lockstep_now ());
+            message_send (MESSAGE_PATH, path, PATH_HANDOFF_SIZE);
+#endif
+            updateFiredBallShooter(ball); //  update the balls path
+#endif
+        }
+    }
+}
+
+
+
+#ifndef MULTI_BALL
+/*
+ * One tick of a fired ball across the shooter's screen, steps it once it reaches the next dot
+ * and hands it over once it reaches the end, the catcher carries on at the speed it was thrown
+ * @param game - game_state_t, the next ball is loaded on the shooter's row
+*/
+static void shooterBall(game_state_t* game)
+{
+    boing_state_t* ball = &game->ball;
+    if (!ballMotionAdvance(&game->ball_motion)) { // not at the next dot yet
+        return;
+    }
+    if (game->round == ROUND_IN_FLIGHT) {
+        if ((*ball).pos.x != 0){
+            updateFiredBallShooter(ball);
+        }
+        else if ((*ball).pos.x == 0) { // ball is at end of the ledmat, ready to be sent to the next fun kit
+            frame_draw_point (ball->pos, 0); // hide the ball
+            (*ball).pos.x = NUM_COLUMNS - 2;
+            (*ball).pos.y = game->shooter_row;
+            roundEvent(game, ROUND_EVENT_LOADED);
+#ifndef BALL_PATH // the path went with the speed when the ball was fired
+            uint8_t handoff[HANDOFF_SIZE];
+            handoff[0] = (*ball).pos.y; // send the row number of the ball when it hits the last column
+            handoff[1] = game->ball_motion.speed;
+            putTick(&handoff[2], lockstep_now ());
+            message_send (MESSAGE_BALL, handoff, HANDOFF_SIZE);
+#endif
+        }
+    }
+}
+#endif
+
+
+
+#ifdef MULTI_BALL
+/*
+ * One tick of every ball on the shooter's screen, the balls that leave it this tick are
+ * handed over together in one message
+ * @param game - game_state_t
+*/
+static void shooterBalls(game_state_t* game)
+{
+    ball_pool_t* pool = &game->ball_pool;
+    uint8_t left = ballPoolAdvanceShooter(pool);
+    uint8_t handoff[BALLS_HANDOFF_SIZE (BALL_POOL_SIZE)];
+    uint8_t slot;
+    if (!left) {
+        return;
+    }
+    putTick(handoff, lockstep_now ());
+    handoff[2] = game->turns; // balls still coming once the catcher has had its last are from a round that is over
+    handoff[3] = 0;
+    for (slot = 0; slot < BALL_POOL_SIZE; slot++) {
+        if (left & (1 << slot)) { // the slot is free again but still holds the row and speed
+            handoff[4 + 2 * handoff[3]] = pool->ball[slot].pos.y;
+            handoff[5 + 2 * handoff[3]] = pool->motion[slot].speed;
+            handoff[3]++;
+        }
+    }
+    message_send (MESSAGE_BALLS, handoff, BALLS_HANDOFF_SIZE (handoff[3]));
+    roundEvent(game, ROUND_EVENT_LOADED); // there is room to load another
+}
+#endif
+
+
+
+#ifdef AI
+/*
+ * Finds the ball on the catcher's screen that reaches the paddle next
+ * @param game - game_state_t
+ * @param ball - set to that ball
+ * returns 0 when there is no ball on the screen
+ */
+static bool nearestBall(const game_state_t* game, boing_state_t* ball)
+{
+#ifdef MULTI_BALL
+    uint8_t slot;
+    bool found = 0;
+    for (slot = 0; slot < BALL_POOL_SIZE; slot++) {
+        if ((game->ball_pool.live & (1 << slot)) && (!found || game->ball_pool.ball[slot].pos.x > ball->pos.x)) {
+            *ball = game->ball_pool.ball[slot];
+            found = 1;
+        }
+    }
+    return found;
+#else
+    *ball = game->ball;
+    return game->round == ROUND_CATCHING && ball->pos.x != NUM_COLUMNS - 1; // one past the paddle is gone
+#endif
+}
+
+
+/*
+ * Computer catcher, moves the paddle one row at a time towards where the next ball
+ * is likely to land, and back to the middle while there is none. Presses are ignored.
+ * @param game - game_state_t
+ */
+static void aiCatcher(game_state_t* game)
+{
+    nav_event_t event;
+    boing_state_t ball;
+    uint8_t paddle = game->paddle;
+    char direction;
+    while (nav_queue_get (&event)) {
+        // the switch is only for the shooter
+    }
+    drawPositionCatcher(paddle);
+    if (game->ai_wait) {
+        game->ai_wait--;
+        return;
+    }
+    if (nearestBall(game, &ball)) {
+        direction = ai_move (paddle, ai_target (ball, paddle));
+    } else {
+        direction = ai_move (paddle, catcherHome(level_paddle_width()));
+    }
+    if (direction) {
+        updatePositionCatcher(&game->paddle, direction);
+        game->ai_wait = AI_REACTION_TICKS - 1;
+    }
+}
+#endif
+
+
+/*
+ * Puts the game back to how it powers up, in place, and starts the next match
+ * from the role screen
+ * @param game - game_state_t
+ */
+static void newMatch(game_state_t* game)
+{
+    forgetBalls(); // a ball from the last match would be the first one caught in this one
+    message_discard (MESSAGE_SCORE);
+    message_discard (MESSAGE_READY);
+    *game = (game_state_t) {0};
+    game->ball = boing_init (NUM_COLUMNS-2, 0, DIR_W); // create a ball
+    startGame(game); // create a player
+}
+
+
+
+/*
+ * Follows the shooter's clock and takes the balls it hands over
+ * @param game - game_state_t
+ * returns 1 once the catcher has had every ball of the round, two can arrive together with MULTI_BALL
+ */
+static bool catcherFollow(game_state_t* game)
+{
+    if (lockstep_follow ()) { // take on the shooter's clock and tick with it
+        sched_restart(ball_task, lockstep_next_time ());
+    }
+    catcherReceive(game);
+    return game->num_balls_received >= BALL_THROWS;
+}
+
+
+#ifdef RING
+/*
+ * Makes this board the catcher for the board upstream, which has taken the token
+ * @param game - game_state_t
+ */
+static void ringCatchToken(game_state_t* game)
+{
+    game->role = 'C';
+    catcher_init(&game->paddle, level_paddle_width());
+    roundEvent(game, ROUND_EVENT_CATCH);
+    forgetBalls();
+    lockstep_resume (); // follow the new shooter's clock from its first sync
+}
+
+
+/*
+ * Link tick for a ring's shooter, it keeps the clock for its catcher until the table
+ * comes back round, and gives up the round to a better token from a board that pushed
+ * at the start about when this one did
+ * @param game - game_state_t
+ */
+static void ringShoot(game_state_t* game)
+{
+    bool last = 0;
+    uint8_t token = ring_token_take ();
+    if (token != RING_TOKEN_NONE) {
+        game->has_shot = 0; // the match ends back round at the other board
+        watchRound(game);
+        if (token == RING_TOKEN_CATCH) { // the board upstream is the shooter now
+            ringCatchToken(game);
+        }
+        return;
+    }
+    lockstep_lead (); // the shooter keeps the clock for its catcher
+    if (ring_table_take (&game->table, 1, &last)) { // the catcher has finished, the round is over
+        if (last) {
+            roundEvent(game, ROUND_EVENT_OVER);
+        } else {
+            watchRound(game);
         }
     }
 }
 
 
+/*
+ * Link tick for a ring's catcher, it follows the shooter until it has had every ball
+ * @param game - game_state_t
+ */
+static void ringCatch(game_state_t* game)
+{
+    uint8_t token = ring_token_take ();
+    if (token == RING_TOKEN_WATCH) { // a better token put another board downstream of its shooter
+        watchRound(game);
+    } else if (token == RING_TOKEN_NONE && catcherFollow(game)) {
+        game->num_balls_received = 0;
+        roundEvent(game, ROUND_EVENT_ALL_IN);
+    }
+}
+
+
+/*
+ * Ends a ring catcher's round, it sends the table round and takes the token unless it
+ * already has this match, then the table stops back at the shooter
+ * @param game - game_state_t, in ROUND_SCORE_SYNC
+ */
+static void ringScore(game_state_t* game)
+{
+    ring_table_add (&game->table, game->balls_caught);
+    ring_table_send (&game->table, game->balls_caught, game->has_shot); // the token is back where it started
+    if (game->has_shot) {
+        roundEvent(game, ROUND_EVENT_OVER);
+    } else {
+        roundEvent(game, ROUND_EVENT_SWITCH);
+        endTurn(game); // this board shoots next
+        resetBallNextPlayer(&game->ball);
+        game->num_balls_fired = 0;
+        game->has_shot = 1;
+        ring_token_send (game->table.rounds);
+        roundEvent(game, ROUND_EVENT_SHOOT);
+    }
+}
+
+
+/*
+ * Link tick for a board watching another pair in the ring, it passes on the table
+ * until it is the last and catches if a better token makes it the catcher
+ * @param game - game_state_t
+ */
+static void ringWatch(game_state_t* game)
+{
+    bool last = 0;
+    uint8_t token = ring_token_take ();
+    if (token == RING_TOKEN_CATCH) {
+        ringCatchToken(game);
+    } else if (token == RING_TOKEN_NONE && ring_table_take (&game->table, 0, &last) && last) {
+        roundEvent(game, ROUND_EVENT_OVER);
+    }
+}
+#else
+/*
+ * Link tick for the shooter, it keeps the clock for both boards until the catcher's
+ * score arrives
+ * @param game - game_state_t
+ */
+static void roundShoot(game_state_t* game)
+{
+    uint8_t payload[MESSAGE_PAYLOAD_MAX];
+    lockstep_lead ();
+    if (message_take (MESSAGE_SCORE, payload)) { // the catcher has sent its score, so the round is over
+        game->other_player_score = payload[0];
+        roundEvent(game, ROUND_EVENT_SCORE);
+    }
+}
+
+
+/*
+ * Link tick for the catcher, it follows the shooter's clock until it has had every ball
+ * and then sends its score
+ * @param game - game_state_t
+ */
+static void roundCatch(game_state_t* game)
+{
+    if (catcherFollow(game) && sendScore(game)) { // send its score to the shooter to keep track of, again next tick if the window is full
+        roundEvent(game, ROUND_EVENT_ALL_IN);
+    }
+}
+#endif
+
+
+/*
+ * Shows the scores once the match is over and starts the next one
+ * @param game - game_state_t
+ */
+static void roundGameOver(game_state_t* game)
+{
+    displayEndScreen(game); // until both players push for a rematch
+    newMatch(game);
+}
+
+
+/*
+ * Nothing to do on a tick, the state only lasts while a screen is up or
+ * within one tick
+ * @param game - game_state_t
+ */
+static void roundIdle(game_state_t* game)
+{
+    (void) game;
+}
+
+
+/*
+ * Drops presses with nothing on the screen for them to move
+ * @param game - game_state_t
+ */
+static void inputIdle(game_state_t* game)
+{
+    nav_event_t event;
+    (void) game;
+    while (nav_queue_get (&event)) {
+        // dropped, not saved for the next round
+    }
+}
+
+
+typedef void (*round_task_t)(game_state_t* game);
+
+/*
+ * What each task does in one round state
+ */
+typedef struct round_tasks_s
+{
+    round_task_t input; // navswitch presses
+    round_task_t ball;  // each tick of the shared clock
+    round_task_t link;  // IR messages and moving the round on
+} RoundTasks;
+
+#ifdef AI
+#define CATCHER_INPUT aiCatcher
+#else
+#define CATCHER_INPUT catcherPlayer
+#endif
+
+#ifdef MULTI_BALL
+#define SHOOTER_BALL shooterBalls // the whole pool in one pass
+#define CATCHER_BALL catcherBalls
+#else
+#define SHOOTER_BALL shooterBall
+#define CATCHER_BALL catcherBall
+#endif
+
+#ifdef RING // the ring has its own way between rounds
+#define LINK_SHOOT ringShoot
+#define LINK_CATCH ringCatch
+#define LINK_SCORE ringScore
+#define LINK_WATCH ringWatch
+#else
+#define LINK_SHOOT roundShoot
+#define LINK_CATCH roundCatch
+#define LINK_SCORE switchRound // both boards count the round the same way
+#define LINK_WATCH roundIdle
+#endif
+
+/* what the input, ball and link tasks do on each tick in each round state */
+static const RoundTasks round_tasks[ROUND_NUM_STATES] PROGMEM = {
+    [ROUND_SELECT] = {inputIdle, roundIdle, roundIdle},
+    [ROUND_AIM] = {shooterPlayer, SHOOTER_BALL, LINK_SHOOT},
+    [ROUND_IN_FLIGHT] = {shooterPlayer, SHOOTER_BALL, LINK_SHOOT},
+    [ROUND_HANDOFF] = {CATCHER_INPUT, CATCHER_BALL, LINK_CATCH},
+    [ROUND_CATCHING] = {CATCHER_INPUT, CATCHER_BALL, LINK_CATCH},
+    [ROUND_SCORE_SYNC] = {inputIdle, roundIdle, LINK_SCORE},
+    [ROUND_SWITCH] = {inputIdle, roundIdle, roundIdle},
+    [ROUND_GAME_OVER] = {inputIdle, roundIdle, roundGameOver},
+    [ROUND_WATCH] = {inputIdle, roundIdle, LINK_WATCH}, // nothing to move while another pair plays
+};
+
+
+
+/*
+ * Input task, takes the navswitch presses and moves the paddle or shooter
+ * @param data - game_state_t
+ */
+static void inputTask(void* data)
+{
+    game_state_t* game = data;
+    round_task_t task = (round_task_t) pgm_read_ptr (&round_tasks[game->round].input);
+    nav_queue_poll ();
+    game->seed_tick++;
+    task(game);
+    PROFILE_PHASE_END (PROFILE_INPUT);
+}
+
+
+
+/*
+ * Ball physics task, moves the balls on at their own speed for every tick of the
+ * shared clock, a ball can move the round on so each tick looks up its state again
+ * @param data - game_state_t
+ */
+static void ballTask(void* data)
+{
+    game_state_t* game = data;
+    uint8_t ticks = lockstep_update (); // usually one, none or two just after the clock is synced
+    round_task_t task;
+    while (ticks--) {
+        task = (round_task_t) pgm_read_ptr (&round_tasks[game->round].ball);
+        task(game);
+    }
+    PROFILE_PHASE_END (PROFILE_BALL);
+}
+
+
+
+/*
+ * IR service task, takes what the other player sent and moves the game between rounds,
+ * one look up in round_tasks whatever state the round is in
+ * @param data - game_state_t
+ */
+static void linkTask(void* data)
+{
+    game_state_t* game = data;
+    round_task_t task = (round_task_t) pgm_read_ptr (&round_tasks[game->round].link);
+    message_service ();
+#ifdef RING
+    ring_flush ();
+#endif
+    task(game);
+    PROFILE_PHASE_END (PROFILE_LINK);
+}
+
+
 
 /*
  *
- * Main routine of the game, contains the game logic.
+ * Main routine of the game, the game logic runs as tasks at their own rates
+ * and the board sleeps in between.
  *
  */
 int main (void)
 {
+    game_state_t game = {0};
+    sched_task_t tasks[] = {
+        SCHED_TASK (inputTask, &game, INPUT_RATE),
+        SCHED_TASK (ballTask, &game, BALL_TICK_RATE),
+        SCHED_TASK (linkTask, &game, LINK_RATE),
+        SCHED_TASK (displayTask, NULL, DISPLAY_RATE), // last so it shows what the other tasks drew
+    };
     initUtils(); // init everything the game needs
-    boing_state_t ball = boing_init (NUM_COLUMNS-2, 0, DIR_W); // create a ball
-    uint8_t ticks = 0, seed_tick = 0, num_balls_fired = 0, num_balls_received = 0, turns = 0, other_player_score = 0;
-    tinygl_point_t catcher_pos_left, catcher_pos_right, shooter_pos;
-    Player player = startGame(&catcher_pos_left, &catcher_pos_right, &shooter_pos); // create a player
-    bool ball_received = 0, ball_off_screen = 0, ball_fired = 0;
-    while (1) {
-        pacer_wait ();
-        navswitch_update ();
-        tinygl_update ();
-        seed_tick++;
-        if (turns == 2) { // if the player has had 2 turns (been in 2 rounds) then the game is over, so display the scores
-            displayEndScreen(&player, other_player_score);
-        } else {
-            if (player.role == 'C'){ // if the player is a catcher
-                catcherPlayer(&player, &catcher_pos_left, &catcher_pos_right, &ball_off_screen, &ticks, &seed_tick, &ball, &ball_received, &num_balls_received); // use the catcher logic
-             }
-        }
-        if (num_balls_received == BALL_THROWS) { // if the catcher has recieved all the balls
-            sendScore(&player, &turns, &num_balls_received); // send its score to the shooter to keep track of
-			ball_fired = 0;
-            endTurn(&player, &catcher_pos_left, &catcher_pos_right, &shooter_pos); // swap players
-            resetBallNextPlayer(&ball); // reset the ball position for the next player
-        }
-        else if (player.role == 'S') { // if the player is a shooter, use the shooters logic
-            shooterPlayer(&shooter_pos, &ticks, &seed_tick, &ball, &num_balls_fired, &ball_fired);
-            int8_t test_ir;
-            if (ir_uart_read_ready_p()) {
-                test_ir = ir_uart_getc();
-                if (test_ir >=0 && test_ir <= NUM_SHOTS) { // ensure that the ir recieved is actually a score from the catcher, not interferance
-                    turns++;
-					other_player_score = test_ir;
-                    endTurn(&player, &catcher_pos_left, &catcher_pos_right, &shooter_pos); // if it is, then that means the game is over so end the turn
-                    num_balls_fired = 0;
-                    clearBuffer();  // clear out anthing that might be in the buffer
-                }
-            }
-        }
+    ball_task = &tasks[1];
+    nav_queue_poll ();
+    if (nav_queue_buttons () & (1 << DIAG_BUTTON)) { // held while the board powered up
+        showDiagnostics();
     }
+    newMatch(&game);
+    sched_run (tasks, sizeof (tasks) / sizeof (tasks[0]), NULL);
+    return 0;
 }
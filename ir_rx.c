@@ -0,0 +1,98 @@
+/** @file ir_rx.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief interrupt driven IR receive ring buffer
+ */
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "system.h"
+#include "timer.h"
+#include "record.h"
+#include "ir_rx.h"
+
+#define IR_RX_MASK (IR_RX_SIZE - 1)
+
+/* head is only written by the interrupt and tail only by the game, both are
+   single bytes so neither needs interrupts disabled to read */
+static uint8_t ir_rx_ring[IR_RX_SIZE];
+static timer_tick_t ir_rx_times[IR_RX_SIZE];
+static volatile uint8_t ir_rx_head;
+static volatile uint8_t ir_rx_tail;
+static volatile uint16_t ir_rx_overflow_count;
+static volatile uint16_t ir_rx_received_count;
+
+
+/*
+ * A byte has arrived at the USART.
+ */
+ISR (USART1_RX_vect)
+{
+    uint8_t byte = UDR1;
+
+    RECORD_RX_BYTE (byte);
+    ir_rx_received_count++;
+    if (((ir_rx_head - ir_rx_tail) & 0xFF) == IR_RX_SIZE) {
+        ir_rx_overflow_count++;
+        return;
+    }
+    ir_rx_ring[ir_rx_head & IR_RX_MASK] = byte;
+    ir_rx_times[ir_rx_head & IR_RX_MASK] = timer_get ();
+    ir_rx_head++;
+}
+
+
+void ir_rx_init (void)
+{
+    ir_rx_head = ir_rx_tail = 0;
+    ir_rx_overflow_count = 0;
+    ir_rx_received_count = 0;
+    UCSR1B |= _BV (RXCIE1);
+    sei ();
+}
+
+
+uint8_t ir_rx_count (void)
+{
+    return ir_rx_head - ir_rx_tail;
+}
+
+
+uint8_t ir_rx_peek (uint8_t offset)
+{
+    return ir_rx_ring[(ir_rx_tail + offset) & IR_RX_MASK];
+}
+
+
+timer_tick_t ir_rx_time (uint8_t offset)
+{
+    return ir_rx_times[(ir_rx_tail + offset) & IR_RX_MASK];
+}
+
+
+void ir_rx_consume (uint8_t count)
+{
+    ir_rx_tail += count;
+}
+
+
+uint16_t ir_rx_overflows (void)
+{
+    uint16_t count;
+
+    cli ();
+    count = ir_rx_overflow_count;
+    sei ();
+    return count;
+}
+
+
+uint16_t ir_rx_received (void)
+{
+    uint16_t count;
+
+    cli ();
+    count = ir_rx_received_count;
+    sei ();
+    return count;
+}
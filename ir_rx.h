@@ -0,0 +1,59 @@
+/** @file ir_rx.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief interrupt driven IR receive ring buffer. The USART receive
+ *  interrupt moves each byte into the ring as soon as it lands, so nothing
+ *  is lost while the game is busy and bytes are only ever removed by
+ *  consuming them. Each byte keeps the time it arrived.
+ */
+
+#ifndef IR_RX_H
+#define IR_RX_H
+
+#include "system.h"
+#include "timer.h"
+
+/* Must be a power of two. */
+#define IR_RX_SIZE 32
+
+/*
+ * Enable the receive interrupt, call after ir_uart_init.
+ */
+void ir_rx_init (void);
+
+/*
+ * Number of bytes waiting in the ring.
+ */
+uint8_t ir_rx_count (void);
+
+/*
+ * Look at a waiting byte without removing it.
+ * @param offset - position from the oldest byte, less than ir_rx_count()
+ */
+uint8_t ir_rx_peek (uint8_t offset);
+
+/*
+ * When a waiting byte arrived.
+ * @param offset - position from the oldest byte, less than ir_rx_count()
+ * returns the timer count at its receive interrupt
+ */
+timer_tick_t ir_rx_time (uint8_t offset);
+
+/*
+ * Remove the oldest bytes from the ring.
+ * @param count - number of bytes, at most ir_rx_count()
+ */
+void ir_rx_consume (uint8_t count);
+
+/*
+ * Number of bytes that arrived while the ring was full and were lost.
+ */
+uint16_t ir_rx_overflows (void);
+
+/*
+ * Number of bytes the receive interrupt has taken, including those lost to
+ * overflows. Wraps at 65536.
+ */
+uint16_t ir_rx_received (void);
+
+#endif
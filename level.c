@@ -0,0 +1,55 @@
+/** @file level.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief difficulty levels
+ */
+
+#include <avr/pgmspace.h>
+#include "system.h"
+#include "level.h"
+
+#define LEVEL_PADDLE 0
+#define LEVEL_JUMP 1
+#define LEVEL_SPEED 2
+#define LEVEL_FIELDS 3
+
+static const uint8_t level_presets[LEVEL_NUM_LEVELS][LEVEL_FIELDS] PROGMEM = {
+    {4, LEVEL_CHANCE (5), 6},  // [rows, threshold, dots/second]
+    {3, LEVEL_CHANCE (10), 7},
+    {2, LEVEL_CHANCE (15), 8},
+    {1, LEVEL_CHANCE (20), 10},
+};
+
+static uint8_t level_playing = LEVEL_DEFAULT;
+
+
+void level_set (uint8_t level)
+{
+    if (level < LEVEL_NUM_LEVELS) {
+        level_playing = level;
+    }
+}
+
+
+uint8_t level_get (void)
+{
+    return level_playing;
+}
+
+
+uint8_t level_paddle_width (void)
+{
+    return pgm_read_byte (&level_presets[level_playing][LEVEL_PADDLE]);
+}
+
+
+uint8_t level_jump_threshold (void)
+{
+    return pgm_read_byte (&level_presets[level_playing][LEVEL_JUMP]);
+}
+
+
+uint8_t level_ball_speed (void)
+{
+    return pgm_read_byte (&level_presets[level_playing][LEVEL_SPEED]);
+}
@@ -0,0 +1,54 @@
+/** @file level.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief difficulty levels. Each level is a preset of how many rows the
+ *  catcher's paddle covers, how often the wind blows the ball off its line
+ *  and how fast a round's first throws go. The level is picked on the role
+ *  screen and the board that pushes first sends it with its role, so both
+ *  boards roll the same gusts. In a ring it goes round with the token.
+ */
+
+#ifndef LEVEL_H
+#define LEVEL_H
+
+#include "system.h"
+
+#define LEVEL_NUM_LEVELS 4
+#define LEVEL_DEFAULT 2 // the game as it always played, a two dot paddle
+
+/* random bytes below a threshold blow the ball south and the same number at
+   the top blow it north */
+#define LEVEL_CHANCE(percent) (((percent) * 256 + 50) / 100)
+
+
+/*
+ * Play at a level from now on, a level out of range is ignored.
+ * @param level - 0 for the easiest to LEVEL_NUM_LEVELS - 1
+ */
+void level_set (uint8_t level);
+
+/*
+ * The level being played.
+ * returns 0 for the easiest to LEVEL_NUM_LEVELS - 1
+ */
+uint8_t level_get (void);
+
+/*
+ * Rows the catcher's paddle covers at this level.
+ * returns 1 to 4
+ */
+uint8_t level_paddle_width (void);
+
+/*
+ * Chance of the wind blowing the ball each way on each move at this level.
+ * returns the threshold from LEVEL_CHANCE
+ */
+uint8_t level_jump_threshold (void);
+
+/*
+ * Speed of a round's first throws at this level.
+ * returns dots per second
+ */
+uint8_t level_ball_speed (void);
+
+#endif
@@ -0,0 +1,140 @@
+/** @file lockstep.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief tick clock shared by both funkits
+ */
+
+#include "system.h"
+#include "timer.h"
+#include "ir_uart.h"
+#include "message.h"
+#include "lockstep.h"
+
+/* One byte at the IR baud rate with start and stop bits, the time from the
+   leader starting a frame to the follower's receive interrupt for it. */
+#define LOCKSTEP_TRANSIT ((timer_tick_t) (TIMER_RATE * 10UL / IR_UART_BAUD_RATE))
+
+#define LOCKSTEP_SYNC_SIZE 4 // [bytes] tick and timer counts into it
+
+static timer_tick_t lockstep_period;
+static timer_tick_t lockstep_start;      // timer count the current tick began at
+static lockstep_tick_t lockstep_tick;
+static lockstep_tick_t lockstep_reported; // tick the last lockstep_update returned up to
+static lockstep_tick_t lockstep_last_sync;
+static uint8_t lockstep_resyncs; // sync frames still to send close together
+static bool lockstep_synced;
+
+
+/*
+ * Count off the ticks that have begun since the clock was last looked at.
+ */
+static void lockstep_advance (void)
+{
+    timer_tick_t now = timer_get ();
+
+    while ((timer_tick_t) (now - lockstep_start) >= lockstep_period) {
+        lockstep_start += lockstep_period;
+        lockstep_tick++;
+    }
+}
+
+
+void lockstep_init (uint16_t rate)
+{
+    lockstep_period = TIMER_RATE / rate;
+    lockstep_tick = lockstep_reported = 0;
+    lockstep_resume ();
+}
+
+
+void lockstep_resume (void)
+{
+    lockstep_start = timer_get ();
+    lockstep_synced = 0;
+    lockstep_resyncs = LOCKSTEP_RESUME_SYNCS;
+    message_discard (MESSAGE_TICK); // its arrival time is too old to compare against
+}
+
+
+uint8_t lockstep_update (void)
+{
+    int16_t ticks;
+
+    lockstep_advance ();
+    ticks = lockstep_tick - lockstep_reported;
+    if (ticks <= 0) {
+        return 0;
+    }
+    lockstep_reported = lockstep_tick;
+    return ticks > 255 ? 255 : ticks;
+}
+
+
+lockstep_tick_t lockstep_now (void)
+{
+    return lockstep_reported;
+}
+
+
+uint8_t lockstep_elapsed (lockstep_tick_t tick)
+{
+    int16_t ticks = lockstep_reported - tick;
+
+    if (!lockstep_synced || ticks < 0) {
+        return 0;
+    }
+    return ticks > 255 ? 255 : ticks;
+}
+
+
+void lockstep_lead (void)
+{
+    uint8_t payload[LOCKSTEP_SYNC_SIZE];
+    timer_tick_t phase;
+    lockstep_tick_t spacing = lockstep_resyncs ? LOCKSTEP_RESYNC_TICKS : LOCKSTEP_SYNC_TICKS;
+
+    if (lockstep_synced && (lockstep_tick_t) (lockstep_tick - lockstep_last_sync) < spacing) {
+        return;
+    }
+    if (!ir_uart_write_finished_p ()) {
+        return; // the frame would queue behind the last one and arrive late
+    }
+    lockstep_advance ();
+    phase = timer_get () - lockstep_start;
+    payload[0] = lockstep_tick & 0xFF;
+    payload[1] = lockstep_tick >> 8;
+    payload[2] = phase & 0xFF;
+    payload[3] = phase >> 8;
+    message_send (MESSAGE_TICK, payload, LOCKSTEP_SYNC_SIZE);
+    lockstep_last_sync = lockstep_tick;
+    lockstep_synced = 1;
+    if (lockstep_resyncs) {
+        lockstep_resyncs--;
+    }
+}
+
+
+bool lockstep_follow (void)
+{
+    uint8_t payload[MESSAGE_PAYLOAD_MAX];
+    timer_tick_t phase;
+
+    if (!message_take (MESSAGE_TICK, payload)) {
+        return 0;
+    }
+    phase = payload[2] | (timer_tick_t) payload[3] << 8;
+    lockstep_tick = payload[0] | (lockstep_tick_t) payload[1] << 8;
+    lockstep_start = message_arrival (MESSAGE_TICK) - LOCKSTEP_TRANSIT - phase;
+    lockstep_advance ();
+    if (!lockstep_synced) { // the jump from wherever this clock was is not time passing
+        lockstep_reported = lockstep_tick;
+        lockstep_synced = 1;
+    }
+    return 1;
+}
+
+
+timer_tick_t lockstep_next_time (void)
+{
+    return lockstep_start + lockstep_period;
+}
@@ -0,0 +1,78 @@
+/** @file lockstep.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief tick clock shared by both funkits. The shooter leads, sending its
+ *  tick and how far into it it is every so often, and the catcher moves its
+ *  own clock onto the shooter's, allowing for the time the first byte of the
+ *  frame spent in the air. Messages stamped with a tick then mean the same
+ *  moment on both boards however long they took to arrive or to be read.
+ */
+
+#ifndef LOCKSTEP_H
+#define LOCKSTEP_H
+
+#include "system.h"
+#include "timer.h"
+
+/* Ticks between sync frames from the leader, clocks drift apart far slower
+   than this. */
+#define LOCKSTEP_SYNC_TICKS 100
+
+/* Sync frames are only sent once, so the first few after a resume go
+   LOCKSTEP_RESYNC_TICKS apart and losing one does not leave the follower on
+   its own clock until the next. */
+#define LOCKSTEP_RESUME_SYNCS 3
+#define LOCKSTEP_RESYNC_TICKS 5
+
+typedef uint16_t lockstep_tick_t;
+
+/*
+ * Start the clock at tick 0, call after sched_init and message_init.
+ * @param rate - ticks per second
+ */
+void lockstep_init (uint16_t rate);
+
+/*
+ * Carry on after a screen that did not keep the clock. The tick count picks up
+ * where it was and a follower waits for the leader's next sync frame.
+ */
+void lockstep_resume (void);
+
+/*
+ * Move the clock on to now, call at least every half timer wrap.
+ * returns the number of ticks since the last call, 0 while the leader's clock
+ * has put this one back a little
+ */
+uint8_t lockstep_update (void);
+
+/*
+ * Tick the last lockstep_update reached.
+ */
+lockstep_tick_t lockstep_now (void);
+
+/*
+ * Ticks from a shared tick up to lockstep_now, for a message stamped with it.
+ * @param tick - tick from the other board
+ * returns 0 until the clock has been synced, at most 255
+ */
+uint8_t lockstep_elapsed (lockstep_tick_t tick);
+
+/*
+ * Lead the clock, sends LOCKSTEP_RESUME_SYNCS sync frames after a resume
+ * and then one every LOCKSTEP_SYNC_TICKS, once the IR transmitter is idle
+ * so each frame goes out straight away.
+ */
+void lockstep_lead (void);
+
+/*
+ * Follow the leader's clock, takes its latest sync frame if one has arrived.
+ * returns 1 if the clock moved, tasks on the clock should be lined up again
+ */
+bool lockstep_follow (void);
+
+/*
+ * Timer count the next tick starts at.
+ */
+timer_tick_t lockstep_next_time (void);
+
+#endif
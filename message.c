@@ -0,0 +1,683 @@
+/** @file message.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief framed, checksummed messages over the IR link
+ */
+
+#include "system.h"
+#include "ir_uart.h"
+#include "ir_rx.h"
+#include "timer.h"
+#include "record.h"
+#include "boot.h"
+#include "message.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define MESSAGE_CRC_POLY 0x07
+
+/* One byte at the IR baud rate with start and stop bits. */
+#define MESSAGE_BYTE_TIME ((timer_tick_t) (TIMER_RATE * 10UL / IR_UART_BAUD_RATE))
+
+/* Quiet on the link for this long with a frame half in, the rest is not coming. */
+#define MESSAGE_GAP (8 * MESSAGE_BYTE_TIME)
+
+/* Time from the UART going quiet to sending everything unacknowledged again,
+   long enough for the other board to finish a few frames of its own and get
+   the acknowledgement out behind them. */
+#define MESSAGE_RESEND ((timer_tick_t) (TIMER_RATE / 4))
+
+#define MESSAGE_WINDOW 8 // frames sent and not yet acknowledged, a power of 2
+#define MESSAGE_WINDOW_MASK (MESSAGE_WINDOW - 1)
+
+/* Window slots a ball handoff cannot take. A round's handoffs can fill the
+   window on a lossy link, the score, ready, role and ring frames that move
+   the match on still get in. */
+#define MESSAGE_CONTROL_SLOTS 3
+
+#ifdef RING
+/* A ring's ack names the last frame filed by its header, check byte and sum,
+   so the board it answers can tell it from the others' acks passing through,
+   and counts the boards it has been through. */
+#define MESSAGE_ACK_HEADER ((4 << 4) | MESSAGE_ACK)
+#define MESSAGE_ACK_FRAME_HEADER 0
+#define MESSAGE_ACK_FRAME_CRC 1
+#define MESSAGE_ACK_FRAME_SUM 2
+#define MESSAGE_ACK_HOPS 3
+
+/* An ack reaches the board it answers within this many boards, the most a
+   ring of eight needs, and goes no further if that board missed it. */
+#define MESSAGE_RING_HOPS 7
+#else
+#define MESSAGE_ACK_HEADER MESSAGE_ACK
+#endif
+
+/* a frame kept until the other board acknowledges it */
+typedef struct message_frame_s
+{
+    uint8_t header;
+    uint8_t crc;
+#ifdef RING
+    uint8_t sum;
+#endif
+    uint8_t payload[MESSAGE_PAYLOAD_MAX];
+} message_frame_t;
+
+/* sequence numbers of frames sent, the window holds those from base up to
+   next in order from the slot of base */
+static message_frame_t message_window[MESSAGE_WINDOW];
+static uint8_t message_tx_slot;
+static uint8_t message_tx_base;
+static uint8_t message_tx_next;
+static timer_tick_t message_tx_time; // when the window last went out or moved on
+static uint8_t message_tx_again; // next frame to send again while going back over the window
+static bool message_going_back;
+
+static uint8_t message_rx_next; // sequence number of the next frame to be filed
+static bool message_ack_due;
+
+#ifdef RING
+static uint8_t message_rx_name[MESSAGE_ACK_HOPS]; // the last frame filed, as acks name it
+static uint8_t message_acked_name[MESSAGE_ACK_HOPS]; // the last frame acknowledged, a repeat ack names it
+#endif
+
+/* one mailbox per type, bit n of pending is set while type n is unread */
+static uint8_t message_mailbox[MESSAGE_NUM_TYPES][MESSAGE_PAYLOAD_MAX];
+static uint16_t message_pending;
+static timer_tick_t message_mailbox_time[MESSAGE_NUM_TYPES];
+
+/* A ball handoff arriving while the last one of its type is unread waits
+   here, two can come in one service when the shooter sends its window
+   again. The latest of any other type replaces the one before. A catcher
+   takes a handoff every tick, so one still here at the next service is
+   for a board that is not catching and is dropped. */
+static uint8_t message_spare[MESSAGE_PAYLOAD_MAX];
+static uint8_t message_spare_type; // MESSAGE_NUM_TYPES while empty
+static timer_tick_t message_spare_time;
+
+static uint16_t message_rejected;
+static uint16_t message_repeats;
+static uint16_t message_resent;
+static uint16_t message_unsent;
+static uint16_t message_round_trip;
+
+static bool message_started; // the IR link is up, it starts on first use
+
+
+uint8_t message_crc8 (uint8_t crc, uint8_t byte)
+{
+    uint8_t bit;
+
+    crc ^= byte;
+    for (bit = 0; bit < 8; bit++) {
+        crc = crc & 0x80 ? (crc << 1) ^ MESSAGE_CRC_POLY : crc << 1;
+    }
+    return crc;
+}
+
+
+void message_init (void)
+{
+    message_pending = 0;
+    message_spare_type = MESSAGE_NUM_TYPES;
+    message_tx_slot = message_tx_base = message_tx_next = 0;
+    message_going_back = 0;
+    message_rx_next = 0;
+    message_ack_due = 0;
+#ifdef RING
+    memset (message_rx_name, 0, sizeof (message_rx_name));
+    memset (message_acked_name, 0, sizeof (message_acked_name));
+#endif
+    message_rejected = message_repeats = message_resent = message_unsent = 0;
+    message_round_trip = MESSAGE_NO_ROUND_TRIP;
+    message_started = 0;
+}
+
+
+/*
+ * Starts the IR link the first time a frame is sent or looked for, so it
+ * costs nothing at power up. The receiver is off until then, which only
+ * loses what arrives before the board first looks.
+ */
+static void message_start (void)
+{
+    if (message_started) {
+        return;
+    }
+    ir_uart_init ();
+    ir_rx_init ();
+    message_started = 1;
+    boot_mark (BOOT_IR);
+}
+
+
+/*
+ * Whether frames of a type are numbered, acknowledged and sent again until
+ * they are. A tick sync or ping is only any use when it is sent, and an
+ * acknowledgement is sent again with the next frame it answers.
+ */
+static bool message_sequenced (uint8_t type)
+{
+    return type != MESSAGE_TICK && type != MESSAGE_PING && type != MESSAGE_PONG && type != MESSAGE_ACK;
+}
+
+
+/*
+ * Whether a type hands a ball over, kept out of the window's last
+ * MESSAGE_CONTROL_SLOTS and filed two deep.
+ */
+static bool message_handoff (uint8_t type)
+{
+    return type == MESSAGE_BALL || type == MESSAGE_BALLS || type == MESSAGE_PATH;
+}
+
+
+#ifdef RING
+/*
+ * A second check on a frame for a ring's acks, a sum of running sums of the
+ * header and payload. CRCs of frames the same length can match when their
+ * bytes differ, so acks for two boards' frames could otherwise be mixed up
+ * with one chance in 256.
+ * @param payload - MESSAGE_LENGTH (header) bytes
+ */
+static uint8_t message_sum (uint8_t header, const uint8_t* payload)
+{
+    uint8_t sum = header;
+    uint8_t total = header;
+    uint8_t i;
+
+    for (i = 0; i < MESSAGE_LENGTH (header); i++) {
+        sum += payload[i];
+        total += sum;
+    }
+    return total;
+}
+
+
+/*
+ * Name a frame the way a ring's ack does.
+ * @param name - filled with MESSAGE_ACK_HOPS bytes
+ */
+static void message_ring_name (const message_frame_t* frame, uint8_t* name)
+{
+    name[MESSAGE_ACK_FRAME_HEADER] = frame->header;
+    name[MESSAGE_ACK_FRAME_CRC] = frame->crc;
+    name[MESSAGE_ACK_FRAME_SUM] = frame->sum;
+}
+#endif
+
+
+/*
+ * Write one frame to the IR UART.
+ * returns its check byte
+ */
+static uint8_t message_put (uint8_t header, uint8_t seq, const uint8_t* payload)
+{
+    uint8_t crc;
+    uint8_t i;
+
+    ir_uart_putc (MESSAGE_SYNC);
+    ir_uart_putc (header);
+    ir_uart_putc (seq);
+    crc = message_crc8 (message_crc8 (MESSAGE_CRC_INIT, header), seq);
+    for (i = 0; i < MESSAGE_LENGTH (header); i++) {
+        ir_uart_putc (payload[i]);
+        crc = message_crc8 (crc, payload[i]);
+    }
+    ir_uart_putc (crc);
+    RECORD_TX_FRAME (crc);
+    return crc;
+}
+
+
+/*
+ * Where a frame in the window is kept.
+ * @param seq - sequence number of a frame from base up to next
+ */
+static message_frame_t* message_frame (uint8_t seq)
+{
+    return &message_window[(message_tx_slot + (uint8_t) (seq - message_tx_base)) & MESSAGE_WINDOW_MASK];
+}
+
+
+bool message_send (message_type_t type, const uint8_t* payload, uint8_t length)
+{
+    uint8_t header = (length << 4) | type;
+    uint8_t waiting = message_tx_next - message_tx_base;
+    message_frame_t* frame;
+    uint8_t i;
+
+    message_start ();
+    if (!message_sequenced (type)) {
+        message_put (header, 0, payload);
+        return 1;
+    }
+    if (waiting == MESSAGE_WINDOW
+        || (message_handoff (type) && waiting >= MESSAGE_WINDOW - MESSAGE_CONTROL_SLOTS)) {
+        message_unsent++; // nothing has got through for most of a round
+        return 0;
+    }
+    frame = message_frame (message_tx_next);
+    frame->header = header;
+    for (i = 0; i < length; i++) {
+        frame->payload[i] = payload[i];
+    }
+    if (message_tx_next == message_tx_base) {
+        message_tx_time = timer_get (); // nothing was waiting, the clock starts now
+    }
+    frame->crc = message_put (header, message_tx_next, frame->payload);
+#ifdef RING
+    frame->sum = message_sum (header, frame->payload);
+#endif
+    message_tx_next++;
+    return 1;
+}
+
+
+void message_withdraw (message_type_t type)
+{
+#ifndef RING
+    uint8_t seq;
+    message_frame_t* frame;
+
+    for (seq = message_tx_base; seq != message_tx_next; seq++) {
+        frame = message_frame (seq);
+        if (MESSAGE_TYPE (frame->header) == type) {
+            frame->header = MESSAGE_VOID; // no payload, the other board may have filed it already
+        }
+    }
+#else
+    (void) type;
+#endif
+}
+
+
+/*
+ * The other board has filed every frame before seq, they can be forgotten.
+ * Acknowledgements come in order, so one for a frame this board has not sent
+ * or has already forgotten means one of the boards has restarted since they
+ * last agreed. The frames waiting are numbered again from the one the other
+ * board wants and sent straight away, rather than being turned down as
+ * repeats or as not the next one for ever.
+ */
+static void message_acknowledged (uint8_t seq)
+{
+    uint8_t waiting = message_tx_next - message_tx_base;
+
+    if ((uint8_t) (seq - message_tx_base) > waiting) {
+        message_tx_base = seq;
+        message_tx_next = seq + waiting;
+        message_tx_time = timer_get () - MESSAGE_RESEND;
+        return;
+    }
+    if (seq != message_tx_base) {
+#ifdef RING
+        message_ring_name (message_frame (seq - 1), message_acked_name);
+#endif
+        message_tx_slot += seq - message_tx_base;
+        message_tx_base = seq;
+        message_tx_time = timer_get ();
+    }
+}
+
+
+/*
+ * Go back and send every unacknowledged frame again once the link has been
+ * quiet for MESSAGE_RESEND without the oldest being acknowledged. One frame
+ * goes each time the UART is idle, putc waits on each byte the UART cannot
+ * take and a whole window at once would hold up every task for half a
+ * second.
+ */
+static void message_resend (void)
+{
+    uint8_t waiting = message_tx_next - message_tx_base;
+    message_frame_t* frame;
+
+    if ((uint8_t) (message_tx_again - message_tx_base) >= waiting) {
+        message_going_back = 0; // all sent again, or acknowledged past the next one
+    }
+    if (!waiting) {
+        return;
+    }
+    if (!ir_uart_write_finished_p ()) {
+        message_tx_time = timer_get (); // counted from the last byte out
+        return;
+    }
+    if (!message_going_back) {
+        if ((timer_tick_t) (timer_get () - message_tx_time) < MESSAGE_RESEND) {
+            return;
+        }
+        message_tx_again = message_tx_base;
+        message_going_back = 1;
+    }
+    frame = message_frame (message_tx_again);
+    message_put (frame->header, message_tx_again, frame->payload);
+    message_resent++;
+    message_tx_again++;
+    message_tx_time = timer_get ();
+}
+
+
+#ifdef RING
+/*
+ * Whether a ring's ack answers this board, it names a frame in the window or
+ * the last one acknowledged. Acks for the other boards name frames this one
+ * never sent, which could only match its own by chance in the header, the
+ * check byte and the sum all three.
+ * @param seq - the frame the ack wants next
+ * @param ack - the ack's payload
+ */
+static bool message_ring_answers (uint8_t seq, const uint8_t* ack)
+{
+    uint8_t waiting = message_tx_next - message_tx_base;
+    uint8_t acked = seq - message_tx_base;
+    uint8_t name[MESSAGE_ACK_HOPS];
+
+    if (acked > waiting) {
+        return 0;
+    }
+    if (!acked) {
+        return !memcmp (ack, message_acked_name, sizeof (name));
+    }
+    message_ring_name (message_frame (seq - 1), name);
+    return !memcmp (ack, name, sizeof (name));
+}
+
+
+/*
+ * In a ring an ack can only reach the board it answers, upstream of the one
+ * that sent it, by going on round the ring. Each board takes the ones that
+ * answer it and passes the rest on.
+ */
+static void message_ring_ack (void)
+{
+    uint8_t seq = ir_rx_peek (2);
+    uint8_t ack[MESSAGE_LENGTH (MESSAGE_ACK_HEADER)];
+    uint8_t i;
+
+    for (i = 0; i < MESSAGE_LENGTH (MESSAGE_ACK_HEADER); i++) {
+        ack[i] = ir_rx_peek (3 + i);
+    }
+    if (message_ring_answers (seq, ack)) {
+        message_acknowledged (seq);
+    } else if (ack[MESSAGE_ACK_HOPS] < MESSAGE_RING_HOPS) {
+        ack[MESSAGE_ACK_HOPS]++;
+        message_put (MESSAGE_ACK_HEADER, seq, ack);
+    }
+}
+#endif
+
+
+/*
+ * Answer a ping with its own payload, time the round trip of a pong or move
+ * the window on for an acknowledgement.
+ * returns 1 if the frame was one of these and is finished with
+ */
+static bool message_link_frame (uint8_t type)
+{
+    uint8_t payload[2];
+    timer_tick_t sent;
+
+    if (type == MESSAGE_PING) {
+        payload[0] = ir_rx_peek (3);
+        payload[1] = ir_rx_peek (4);
+        message_send (MESSAGE_PONG, payload, 2);
+        return 1;
+    }
+    if (type == MESSAGE_PONG) {
+        sent = ir_rx_peek (3) | (timer_tick_t) ir_rx_peek (4) << 8;
+        message_round_trip = (uint32_t) (timer_tick_t) (ir_rx_time (0) - sent) * 1000 / TIMER_RATE;
+        return 1;
+    }
+    if (type == MESSAGE_ACK) {
+#ifdef RING
+        message_ring_ack ();
+#else
+        message_acknowledged (ir_rx_peek (2));
+#endif
+        return 1;
+    }
+    return 0;
+}
+
+
+/*
+ * The frame at the front of the ring passed its check, file it unless it is
+ * numbered and not the next one. One sent again after its acknowledgement
+ * was lost is a repeat, one after a lost frame waits for that to be sent
+ * again, either way the acknowledgement says which frame is wanted. A third
+ * ball handoff of a type before the game has taken the first is not filed
+ * either, it is sent again once the game has made room.
+ */
+static void message_deliver (void)
+{
+    uint8_t header = ir_rx_peek (1);
+    uint8_t seq = ir_rx_peek (2);
+    uint8_t type = MESSAGE_TYPE (header);
+    bool spare = message_handoff (type) && message_waiting (type, NULL);
+    uint8_t* box = spare ? message_spare : message_mailbox[type];
+    uint8_t i;
+
+    if (message_sequenced (type)) {
+        message_ack_due = 1;
+        if (seq != message_rx_next) {
+            if ((uint8_t) (message_rx_next - seq) <= MESSAGE_WINDOW) {
+                message_repeats++;
+            }
+            return;
+        }
+        if (spare && message_spare_type != MESSAGE_NUM_TYPES) {
+            return;
+        }
+        message_rx_next++;
+#ifdef RING
+        message_rx_name[MESSAGE_ACK_FRAME_HEADER] = header;
+        message_rx_name[MESSAGE_ACK_FRAME_CRC] = ir_rx_peek (3 + MESSAGE_LENGTH (header));
+#endif
+        if (type == MESSAGE_VOID) {
+            return;
+        }
+    } else if (message_link_frame (type)) {
+        return;
+    }
+    for (i = 0; i < MESSAGE_LENGTH (header); i++) {
+        box[i] = ir_rx_peek (3 + i);
+    }
+#ifdef RING
+    if (message_sequenced (type)) {
+        message_rx_name[MESSAGE_ACK_FRAME_SUM] = message_sum (header, box);
+    }
+#endif
+    if (spare) {
+        message_spare_type = type;
+        message_spare_time = ir_rx_time (0);
+        return;
+    }
+    message_mailbox_time[type] = ir_rx_time (0);
+    message_pending |= 1 << type;
+}
+
+
+/*
+ * Whether the last byte in the ring came in longer ago than any gap inside
+ * a frame.
+ */
+static bool message_stalled (void)
+{
+    return (timer_tick_t) (timer_get () - ir_rx_time (ir_rx_count () - 1)) >= MESSAGE_GAP;
+}
+
+
+/*
+ * Frames are only taken out of the ring once all of their bytes are in, and
+ * anything that is not a good frame is skipped one byte at a time so a SYNC
+ * inside a damaged frame still gets a chance to start the next one. A SYNC
+ * from noise would otherwise hold up the ring until enough bytes came after
+ * it to fail the check, which may be never if the other board is waiting on
+ * this one.
+ */
+void message_service (void)
+{
+    uint8_t header, length, crc, i;
+
+    message_start ();
+    message_spare_type = MESSAGE_NUM_TYPES; // still there, the game has not taken its type since last time and has no use for it
+    while (ir_rx_count ()) {
+        if (ir_rx_peek (0) != MESSAGE_SYNC) {
+            ir_rx_consume (1);
+            message_rejected++;
+            continue;
+        }
+        if (ir_rx_count () < 2) {
+            if (!message_stalled ()) {
+                break;
+            }
+            ir_rx_consume (1);
+            message_rejected++;
+            continue;
+        }
+        header = ir_rx_peek (1);
+        length = MESSAGE_LENGTH (header);
+        if (MESSAGE_TYPE (header) >= MESSAGE_NUM_TYPES || length > MESSAGE_PAYLOAD_MAX) {
+            ir_rx_consume (1);
+            message_rejected++;
+            continue;
+        }
+        if (ir_rx_count () < length + MESSAGE_OVERHEAD) {
+            if (!message_stalled ()) {
+                break; // rest of the frame is still on its way
+            }
+            ir_rx_consume (1);
+            message_rejected++;
+            continue;
+        }
+        crc = MESSAGE_CRC_INIT;
+        for (i = 1; i < length + MESSAGE_OVERHEAD - 1; i++) {
+            crc = message_crc8 (crc, ir_rx_peek (i));
+        }
+        if (crc != ir_rx_peek (length + MESSAGE_OVERHEAD - 1)) {
+            ir_rx_consume (1);
+            message_rejected++;
+            continue;
+        }
+        message_deliver ();
+        ir_rx_consume (length + MESSAGE_OVERHEAD);
+    }
+    if (message_ack_due) {
+#ifdef RING
+        uint8_t ack[MESSAGE_LENGTH (MESSAGE_ACK_HEADER)] = {0};
+
+        memcpy (ack, message_rx_name, sizeof (message_rx_name));
+        message_put (MESSAGE_ACK_HEADER, message_rx_next, ack); // one for everything filed this time
+#else
+        message_put (MESSAGE_ACK_HEADER, message_rx_next, NULL);
+#endif
+        message_ack_due = 0;
+    }
+    message_resend ();
+}
+
+
+bool message_take (message_type_t type, uint8_t* payload)
+{
+    uint8_t i;
+
+    if (!(message_pending & (1 << type))) {
+        return 0;
+    }
+    message_pending &= ~(1 << type);
+    if (payload) {
+        for (i = 0; i < MESSAGE_PAYLOAD_MAX; i++) {
+            payload[i] = message_mailbox[type][i];
+        }
+    }
+    if (message_spare_type == type) { // the handoff behind it is next
+        memcpy (message_mailbox[type], message_spare, MESSAGE_PAYLOAD_MAX);
+        message_mailbox_time[type] = message_spare_time;
+        message_pending |= 1 << type;
+        message_spare_type = MESSAGE_NUM_TYPES;
+    }
+    return 1;
+}
+
+
+bool message_waiting (message_type_t type, uint8_t* payload)
+{
+    if (!(message_pending & (1 << type))) {
+        return 0;
+    }
+    if (payload) {
+        memcpy (payload, message_mailbox[type], MESSAGE_PAYLOAD_MAX);
+    }
+    return 1;
+}
+
+
+timer_tick_t message_arrival (message_type_t type)
+{
+    return message_mailbox_time[type];
+}
+
+
+void message_discard (message_type_t type)
+{
+    message_pending &= ~(1 << type);
+    if (message_spare_type == type) {
+        message_spare_type = MESSAGE_NUM_TYPES;
+    }
+}
+
+
+void message_ping (void)
+{
+    timer_tick_t now = timer_get ();
+    uint8_t payload[2];
+
+    payload[0] = now & 0xFF;
+    payload[1] = now >> 8;
+    message_send (MESSAGE_PING, payload, 2);
+}
+
+
+void message_stats (message_stats_t* stats)
+{
+    stats->received = ir_rx_received ();
+    stats->rejected = message_rejected;
+    stats->discarded = ir_rx_overflows ();
+    stats->repeats = message_repeats;
+    stats->resent = message_resent;
+    stats->unsent = message_unsent;
+    stats->round_trip = message_round_trip;
+}
+
+
+void message_stats_encode (const message_stats_t* stats, uint8_t* payload)
+{
+    const uint16_t counts[MESSAGE_STATS_SIZE / 2] = {
+        stats->received, stats->rejected, stats->discarded, stats->repeats, stats->resent, stats->unsent, stats->round_trip
+    };
+    uint8_t i;
+
+    for (i = 0; i < MESSAGE_STATS_SIZE / 2; i++) {
+        payload[2 * i] = counts[i] & 0xFF;
+        payload[2 * i + 1] = counts[i] >> 8;
+    }
+}
+
+
+void message_stats_decode (message_stats_t* stats, const uint8_t* payload)
+{
+    uint16_t counts[MESSAGE_STATS_SIZE / 2];
+    uint8_t i;
+
+    for (i = 0; i < MESSAGE_STATS_SIZE / 2; i++) {
+        counts[i] = payload[2 * i] | (uint16_t) payload[2 * i + 1] << 8;
+    }
+    stats->received = counts[0];
+    stats->rejected = counts[1];
+    stats->discarded = counts[2];
+    stats->repeats = counts[3];
+    stats->resent = counts[4];
+    stats->unsent = counts[5];
+    stats->round_trip = counts[6];
+}
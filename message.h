@@ -0,0 +1,198 @@
+/** @file message.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief framed, checksummed messages over the IR link
+ *
+ *  A frame is SYNC, TYPE, SEQ, PAYLOAD and CRC. The high nibble of TYPE is
+ *  the payload length and the low nibble the message type. SEQ counts frames
+ *  sent by the board and CRC is a CRC-8 (polynomial 0x07, starting from
+ *  0xFF) over TYPE, SEQ and PAYLOAD. Frames that fail the check are
+ *  dropped, so a byte garbled by ambient IR costs one frame instead of
+ *  desyncing a round. Frames are read from the ir_rx ring, and the IR UART
+ *  and the ring are started by the first message_send or message_service
+ *  rather than at power up.
+ *
+ *  Between two boards a dropped frame is sent again. Each board files the
+ *  other's frames in SEQ order, answers with a MESSAGE_ACK naming the next
+ *  one it wants, and sends everything not yet acknowledged again when the
+ *  link has been quiet for a while without one. An ack for a frame the
+ *  sender does not have means one board restarted, and the sender numbers
+ *  what it has waiting from the one asked for. Tick syncs, pings and acks
+ *  carry SEQ 0 and are only sent once.
+ *
+ *  In a RING each board does the same with the board downstream, but can
+ *  only hear the one upstream. Its acks name the last frame filed, by its
+ *  header, check byte and a sum of its bytes, and go on round the ring, each
+ *  board passing on the ones that do not answer it, until they reach the
+ *  board they answer. Every hop of a frame passed round is then sent again
+ *  until it gets through. A restarted board is not caught up with in a ring.
+ *
+ *  The link keeps counts of what it has had to throw away, to tell a noisy
+ *  or misaligned link from a logic bug, and answers pings from the other
+ *  board itself so the round trip can be timed whatever screen it is on.
+ */
+
+#ifndef MESSAGE_H
+#define MESSAGE_H
+
+#include "system.h"
+#include "timer.h"
+
+#define MESSAGE_PAYLOAD_MAX 14 // a tick's worth of MULTI_BALL handoffs and the link stats
+
+#define MESSAGE_SYNC 0xA5
+
+/* A check starts here rather than at 0. From 0 a run of zero bytes checks
+   out, so a frame whose header byte was lost could pass as a zero length
+   frame made of the zeros behind it, and blank storage as a snapshot. */
+#define MESSAGE_CRC_INIT 0xFF
+
+/* SYNC, TYPE, SEQ and CRC around the payload */
+#define MESSAGE_OVERHEAD 4
+
+#define MESSAGE_TYPE(header) ((header) & 0x0F)
+#define MESSAGE_LENGTH(header) ((header) >> 4)
+
+typedef enum message_type
+{
+    MESSAGE_ROLE,   // role picked by the sender, 'C' or 'S', and the level, see level.h
+    MESSAGE_BALL,   // row the ball left the shooter's screen on and its speed
+    MESSAGE_SCORE,  // catcher's score and turn count at the end of a round
+    MESSAGE_READY,  // player pushed in on the switching screen
+    MESSAGE_PATH,   // whole flight of a ball just fired and its speed, see ball.h BALL_PATH
+    MESSAGE_TICK,   // sender's tick clock, see lockstep.h
+    MESSAGE_BALLS,  // every ball that left the shooter's screen in a tick, see ball.h MULTI_BALL
+    MESSAGE_PING,   // sender's timer count, answered by the link not the game
+    MESSAGE_PONG,   // a ping's timer count sent back
+    MESSAGE_STATS,  // sender's link stats, see message_stats_encode
+    MESSAGE_TOKEN,  // a RING board has taken the ball, how many boards have passed the word on, when it was taken, the level and the taker's stack_noise word
+    MESSAGE_TABLE,  // RING scores so far, passed round from the catcher at the end of a round
+    MESSAGE_ACK,    // every frame before the one in its SEQ has been filed, answered by the link not the game
+    MESSAGE_VOID,   // a frame taken back before it was acknowledged, filed and thrown away by the link
+    MESSAGE_NUM_TYPES
+} message_type_t;
+
+#define MESSAGE_STATS_SIZE 14 // [bytes] seven 16 bit counts
+#define MESSAGE_NO_ROUND_TRIP 0xFFFF
+
+/*
+ * Link quality counts since power on, each wraps at 65536
+ * received: bytes the receive interrupt took
+ * rejected: bytes skipped looking for a good frame, noise and damaged or unknown frames
+ * discarded: bytes lost unread because the receive ring was full
+ * repeats: good frames that had already been filed, sent again after their acknowledgement was lost
+ * resent: frames this board sent again because they had not been acknowledged
+ * unsent: frames message_send turned down because the window of unacknowledged frames was full
+ * round_trip: [ms] from the last answered ping to its pong, MESSAGE_NO_ROUND_TRIP before one
+ */
+typedef struct message_stats_s
+{
+    uint16_t received;
+    uint16_t rejected;
+    uint16_t discarded;
+    uint16_t repeats;
+    uint16_t resent;
+    uint16_t unsent;
+    uint16_t round_trip;
+} message_stats_t;
+
+/*
+ * Fold one byte into the frames' CRC-8, start from MESSAGE_CRC_INIT.
+ * @param crc - CRC of the bytes so far
+ * @param byte - next byte
+ * returns the CRC with byte included
+ */
+uint8_t message_crc8 (uint8_t crc, uint8_t byte);
+
+/*
+ * Reset the mailboxes, the IR link starts when it is first used.
+ */
+void message_init (void);
+
+/*
+ * Send one frame.
+ * @param type - type of the message
+ * @param payload - payload bytes, may be NULL when length is 0
+ * @param length - number of payload bytes, at most MESSAGE_PAYLOAD_MAX
+ * returns 0 if the frame was dropped and counted in the stats as unsent,
+ * a numbered frame is when eight of them are still waiting for
+ * acknowledgement, or five for a ball handoff, which leaves room for the
+ * frames that move a match on. Send it again on a later tick.
+ */
+bool message_send (message_type_t type, const uint8_t* payload, uint8_t length);
+
+/*
+ * Take back every frame of a type still waiting for acknowledgement, each
+ * goes out again as a MESSAGE_VOID and holds its place until it is
+ * acknowledged. In a RING nothing is taken back, acks name the frames they
+ * answer by their bytes.
+ * @param type - type of message that is no use to the other board any more
+ */
+void message_withdraw (message_type_t type);
+
+/*
+ * File every complete frame waiting in the IR receive ring in its type's
+ * mailbox, a later one replaces one not yet taken except for ball
+ * handoffs, which queue two deep. This is the only place received bytes
+ * are read, call it once per tick.
+ */
+void message_service (void);
+
+/*
+ * Take the latest message of a type out of its mailbox, or the oldest
+ * ball handoff.
+ * @param type - type of message wanted
+ * @param payload - buffer of MESSAGE_PAYLOAD_MAX bytes for the payload, may be NULL
+ * returns 1 if one had arrived since the last take
+ */
+bool message_take (message_type_t type, uint8_t* payload);
+
+/*
+ * Check for a message of a type without taking it.
+ * @param type - type of message wanted
+ * @param payload - buffer of MESSAGE_PAYLOAD_MAX bytes for a copy of the
+ * payload, may be NULL
+ * returns 1 if one is waiting in its mailbox
+ */
+bool message_waiting (message_type_t type, uint8_t* payload);
+
+/*
+ * When the last message of a type to be taken started to arrive.
+ * @param type - type of message
+ * returns the timer count its first byte was received at
+ */
+timer_tick_t message_arrival (message_type_t type);
+
+/*
+ * Drop anything waiting in a type's mailbox.
+ * @param type - type of message to forget
+ */
+void message_discard (message_type_t type);
+
+/*
+ * Ping the other board, its pong updates the round trip in the stats when
+ * message_service files it.
+ */
+void message_ping (void);
+
+/*
+ * Read the link quality counts.
+ * @param stats - filled in
+ */
+void message_stats (message_stats_t* stats);
+
+/*
+ * Pack stats into a MESSAGE_STATS payload, little endian in struct order.
+ * @param stats - stats to send
+ * @param payload - MESSAGE_STATS_SIZE bytes to fill
+ */
+void message_stats_encode (const message_stats_t* stats, uint8_t* payload);
+
+/*
+ * Unpack a MESSAGE_STATS payload.
+ * @param stats - filled in
+ * @param payload - MESSAGE_STATS_SIZE bytes from message_stats_encode
+ */
+void message_stats_decode (message_stats_t* stats, const uint8_t* payload);
+
+#endif
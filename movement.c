@@ -4,112 +4,163 @@
  *  @brief movement of a catcher or shooter player - module 
  */
 
-#include "pacer.h"
 #include "tinygl.h"
 #include "../fonts/font5x7_1.h"
 #include "navswitch.h"
+#include "frame.h"
 #include "movement.h"
 
 #define NUM_ROWS 7
 #define NUM_COLUMNS 5
 
 #define Y_MIDDLE (NUM_ROWS/2)
+#define PADDLE_ROWS ((1 << NUM_ROWS) - 1) // a bit for every row
+
+
+/*
+ * Where a paddle of a width starts, in the middle of the column.
+ * @param width - rows it covers, 1 to PADDLE_WIDTH_MAX
+ * returns the row mask
+ */
+uint8_t catcherHome(uint8_t width) {
+    return ((1 << width) - 1) << ((NUM_ROWS - width + 1) / 2);
+}
 
 
 /*
  * Initialise the catcher LED's to show them on the board at
  * the default location.
- * @param catcher_pos_left - pointer to a coordinate on the LEDMAT (LEFT SIDE)
- * @param catcher_pos_right -  pointer to a coordinate on the LEDMAT (RIGHT SIDE)
+ * @param paddle - pointer to the rows the paddle covers
+ * @param width - rows it covers, 1 to PADDLE_WIDTH_MAX
  */
-void catcher_init(tinygl_point_t* catcher_pos_left, tinygl_point_t* catcher_pos_right) { 
-    tinygl_clear(); 
-    catcher_pos_right->x = NUM_COLUMNS-1;
-    catcher_pos_right->y = Y_MIDDLE;
-    catcher_pos_left->x = NUM_COLUMNS-1;
-    catcher_pos_left->y = Y_MIDDLE+1;
-    tinygl_draw_point(*catcher_pos_left,1);
-    tinygl_draw_point(*catcher_pos_right,1);
+void catcher_init(uint8_t* paddle, uint8_t width) { 
+    frame_clear();
+    *paddle = catcherHome(width);
+    drawPositionCatcher(*paddle);
 }
 
 
 /*
- * Updates the posistion of the catcher player to the left or the right, 
- * also accounts for edge cases.
- * @param catcher_pos_left - pointer to a coordinate on the LEDMAT (LEFT SIDE)
- * @param catcher_pos_right -  pointer to a coordinate on the LEDMAT (RIGHT SIDE)
+ * Moves a paddle one row, dots going off one edge come back on the other.
+ * @param paddle - rows the paddle covers
+ * @param direction - 'N' or 'S', anything else leaves it where it is
+ * returns the rows it covers after the move
  */
-void updatePositionCatcher(tinygl_point_t* catcher_pos_left, tinygl_point_t* catcher_pos_right, char direction) {
-    turnOffPositionCatcher(catcher_pos_left, catcher_pos_right); // turn off LEDs
-    
-    if (direction == 'N') { // check direction
-        catcher_pos_right->y -= 1;
-        catcher_pos_left->y -= 1;
-        
-    } else  if (direction == 'S'){
-        catcher_pos_right->y += 1;
-        catcher_pos_left->y += 1;
+uint8_t rotatePaddle(uint8_t paddle, char direction) {
+    if (direction == 'N') { // towards row 0, the top dot comes round to the bottom
+        return (paddle >> 1) | ((paddle & 1) << (NUM_ROWS - 1));
+    } else if (direction == 'S') {
+        return ((paddle << 1) | (paddle >> (NUM_ROWS - 1))) & PADDLE_ROWS;
     }
-    if (catcher_pos_left->y == NUM_ROWS) {
-        catcher_pos_left->y = 1;
-        catcher_pos_right->y = 0;
-    } else if (catcher_pos_right->y == -1) {
-        catcher_pos_right->y = NUM_ROWS -2;
-        catcher_pos_left->y = NUM_ROWS -1;
+    return paddle;
+}
+
+
+/*
+ * Updates the posistion of the catcher player to the left or the right, 
+ * also accounts for edge cases. A move leaves a ghost where it was.
+ * @param paddle - pointer to the rows the paddle covers
+ */
+void updatePositionCatcher(uint8_t* paddle, char direction) {
+    if (direction == 'N' || direction == 'S') {
+        ghostPositionCatcher(*paddle);
+    } else {
+        turnOffPositionCatcher(*paddle); // turn off LEDs, it is only being redrawn
     }
-    tinygl_draw_point(*catcher_pos_left,1); // draw both after they have moved
-    tinygl_draw_point(*catcher_pos_right,1);
+    *paddle = rotatePaddle(*paddle, direction);
+    drawPositionCatcher(*paddle); // draw every dot after they have moved
 }
 
 
 /*
  * Turn off the LED's on the catcher (just before it gets updated).
- * @param catcher_pos_left - pointer to a coordinate on the LEDMAT (LEFT SIDE)
- * @param catcher_pos_right -  pointer to a coordinate on the LEDMAT (RIGHT SIDE)
+ * @param paddle - rows the paddle covers
+ */
+void turnOffPositionCatcher(uint8_t paddle) {
+    tinygl_coord_t row;
+    for (row = 0; row < NUM_ROWS; row++) {
+        if (paddle & (1 << row)) {
+            frame_draw_point(tinygl_point(NUM_COLUMNS-1, row),0);
+        }
+    }
+}
+
+
+/*
+ * Turn off the catcher leaving a dimmed ghost of it that fades out.
+ * @param paddle - rows the paddle covers
+ */
+void ghostPositionCatcher(uint8_t paddle) {
+    tinygl_coord_t row;
+    for (row = 0; row < NUM_ROWS; row++) {
+        if (paddle & (1 << row)) {
+            frame_trail(tinygl_point(NUM_COLUMNS-1, row));
+        }
+    }
+}
+
+
+/*
+ * Draws the catcher paddle, for when something else has drawn over it.
+ * @param paddle - rows the paddle covers
+ */
+void drawPositionCatcher(uint8_t paddle) {
+    tinygl_coord_t row;
+    for (row = 0; row < NUM_ROWS; row++) {
+        if (paddle & (1 << row)) {
+            frame_draw_point(tinygl_point(NUM_COLUMNS-1, row),1);
+        }
+    }
+}
+
+
+/*
+ * Checks if a ball in the paddle's column is on the paddle, one AND against the
+ * ball's row.
+ * @param paddle - rows the paddle covers
+ * @param row - row of the ball
  */
-void turnOffPositionCatcher(tinygl_point_t* catcher_pos_left, tinygl_point_t* catcher_pos_right) {
-    tinygl_draw_point(*catcher_pos_left,0);
-    tinygl_draw_point(*catcher_pos_right,0);
+bool catcherCovers(uint8_t paddle, tinygl_coord_t row) {
+    return (paddle & (1 << row)) != 0;
 }
 
 
 /*
  * Turns of the LED for the shooter (just before it gets updated).
- * @param shooter_pos - pointer to a coordinate on the LEDMAT for the shooter
+ * @param shooter_row - the shooter's row
  */
-void turnOffPositionShooter(tinygl_point_t* shooter_pos) {
-    tinygl_draw_point(*shooter_pos,0); 
+void turnOffPositionShooter(tinygl_coord_t shooter_row) {
+    frame_draw_point(tinygl_point(NUM_COLUMNS-1, shooter_row),0); 
 }
 
 
 /*
  * Initialise the shooters LED on the LEDMAT.
- * @param shooter_pos - pointer to the shooter coordinate
+ * @param shooter_row - pointer to the shooter's row, it is put in the middle
  */
-void shooter_init(tinygl_point_t* shooter_pos) { 
-    tinygl_clear();
-    shooter_pos->x = NUM_COLUMNS-1; //set the column position
-    shooter_pos->y = Y_MIDDLE; // set to middle of screen
-    tinygl_draw_point(*shooter_pos,1); 
+void shooter_init(tinygl_coord_t* shooter_row) { 
+    frame_clear();
+    *shooter_row = Y_MIDDLE; // set to middle of screen
+    frame_draw_point(tinygl_point(NUM_COLUMNS-1, *shooter_row),1); 
 }
 
 
 /*
  * Updates the shooters current position to either to the left or right,
  * also accounts for the edge cases.
- * @param shooter_pos - pointer to the shooter coordinate
+ * @param shooter_row - pointer to the shooter's row
  */
-void updatePositionShooter(tinygl_point_t* shooter_pos, char direction) {
-    turnOffPositionShooter(shooter_pos);
+void updatePositionShooter(tinygl_coord_t* shooter_row, char direction) {
+    turnOffPositionShooter(*shooter_row);
     if (direction == 'N') { // see which direction the ball is in and move it accodingly
-        shooter_pos->y -= 1;   
+        *shooter_row -= 1;   
     } else if (direction == 'S') {
-        shooter_pos->y += 1;
+        *shooter_row += 1;
     }
-    if (shooter_pos->y == 7) {
-        shooter_pos->y = 0;   
-    } else if (shooter_pos->y == -1) {
-        shooter_pos->y = 6;
+    if (*shooter_row == 7) {
+        *shooter_row = 0;   
+    } else if (*shooter_row == -1) {
+        *shooter_row = 6;
     }
-    tinygl_draw_point(*shooter_pos,1); // draw the new position
+    frame_draw_point(tinygl_point(NUM_COLUMNS-1, *shooter_row),1); // draw the new position
 }
@@ -7,53 +7,90 @@
 #ifndef MOVEMENT_H
 #define MOVEMENT_H
 
-#include "pacer.h"
 #include "tinygl.h"
 #include "../fonts/font5x7_1.h"
 #include "navswitch.h"
 
 /*
  * Initialise the shooters LED on the LEDMAT.
- * @param shooter_pos - pointer to the shooter coordinate
+ * @param shooter_row - pointer to the shooter's row, it is put in the middle
  */
-void shooter_init(tinygl_point_t* shooter_pos);
+void shooter_init(tinygl_coord_t* shooter_row);
 
 /*
  * Updates the shooters current posistion to either to the left or right,
  * also accounts for the edge cases.
- * @param shooter_pos - pointer to the shooter coordinate
+ * @param shooter_row - pointer to the shooter's row
  */
-void updatePositionShooter(tinygl_point_t* shooter_pos, char direction);
+void updatePositionShooter(tinygl_coord_t* shooter_row, char direction);
 
 
 /*
  * Turns of the LED for the shooter (just before it gets updated).
- * @param shooter_pos - pointer to a coordinate on the LEDMAT for the shooter
+ * @param shooter_row - the shooter's row
  */
-void turnOffPositionShooter(tinygl_point_t* shooter_pos);
+void turnOffPositionShooter(tinygl_coord_t shooter_row);
+
+/*
+ * The catcher paddle is a row mask, bit n set for a dot on row n, so it can be
+ * any width from 1 to PADDLE_WIDTH_MAX and a move is a rotate through the rows.
+ */
+#define PADDLE_WIDTH_MAX 4
 
 /*
  * Turn off the LED's on the catcher (just before it gets updated).
- * @param catcher_pos_left - pointer to a coordinate on the LEDMAT (LEFT SIDE)
- * @param catcher_pos_right -  pointer to a coordinate on the LEDMAT (RIGHT SIDE)
+ * @param paddle - rows the paddle covers
+ */
+void turnOffPositionCatcher(uint8_t paddle);
+
+/*
+ * Turn off the catcher leaving a dimmed ghost of it that fades out.
+ * @param paddle - rows the paddle covers
+ */
+void ghostPositionCatcher(uint8_t paddle);
+
+/*
+ * Where a paddle of a width starts, in the middle of the column.
+ * @param width - rows it covers, 1 to PADDLE_WIDTH_MAX
+ * returns the row mask
  */
-void turnOffPositionCatcher(tinygl_point_t* catcher_pos_left, tinygl_point_t* catcher_pos_right);
+uint8_t catcherHome(uint8_t width);
 
 /*
  * Initialise the catcher LED's to show them on the board at
  * the default location
- * @param catcher_pos_left - pointer to a coordinate on the LEDMAT (LEFT SIDE)
- * @param catcher_pos_right -  pointer to a coordinate on the LEDMAT (RIGHT SIDE)
+ * @param paddle - pointer to the rows the paddle covers
+ * @param width - rows it covers, 1 to PADDLE_WIDTH_MAX
  */
-void catcher_init(tinygl_point_t* catcher_pos_left, tinygl_point_t* catcher_pos_right);
+void catcher_init(uint8_t* paddle, uint8_t width);
+
+/*
+ * Moves a paddle one row, dots going off one edge come back on the other.
+ * @param paddle - rows the paddle covers
+ * @param direction - 'N' or 'S', anything else leaves it where it is
+ * returns the rows it covers after the move
+ */
+uint8_t rotatePaddle(uint8_t paddle, char direction);
 
 
 /*
  * Updates the posistion of the catcher player to the left or the right, 
- * also accounts for edge cases.
- * @param catcher_pos_left - pointer to a coordinate on the LEDMAT (LEFT SIDE)
- * @param catcher_pos_right -  pointer to a coordinate on the LEDMAT (RIGHT SIDE)
+ * also accounts for edge cases. A move leaves a ghost where it was.
+ * @param paddle - pointer to the rows the paddle covers
+ */
+void updatePositionCatcher(uint8_t* paddle, char direction);
+
+/*
+ * Draws the catcher paddle, for when something else has drawn over it.
+ * @param paddle - rows the paddle covers
+ */
+void drawPositionCatcher(uint8_t paddle);
+
+/*
+ * Checks if a ball in the paddle's column is on the paddle.
+ * @param paddle - rows the paddle covers
+ * @param row - row of the ball
  */
-void updatePositionCatcher(tinygl_point_t* catcher_pos_left, tinygl_point_t* catcher_pos_right, char direction);
+bool catcherCovers(uint8_t paddle, tinygl_coord_t row);
 
 #endif
@@ -0,0 +1,124 @@
+/** @file nav_queue.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief interrupt captured navswitch presses
+ */
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include "system.h"
+#include "pio.h"
+#include "navswitch.h"
+#include "timer.h"
+#include "record.h"
+#include "nav_queue.h"
+
+#define NAV_QUEUE_MASK (NAV_QUEUE_SIZE - 1)
+
+/* A switch bounces for a few ms after each edge, later edges inside this are ignored. */
+#define NAV_QUEUE_DEBOUNCE (TIMER_RATE / 100)
+
+/* PCINT8 to 11 are PC6, PC5, PC4 and PC2, the navswitch pins with a pin
+   change interrupt. PC7 has none and is left to nav_queue_poll. */
+#define NAV_QUEUE_PCINTS 0x0F
+
+static const pio_t nav_queue_pios[NAVSWITCH_NUM] PROGMEM =
+{
+    NAVSWITCH_NORTH_PIO, NAVSWITCH_EAST_PIO, NAVSWITCH_SOUTH_PIO,
+    NAVSWITCH_WEST_PIO, NAVSWITCH_PUSH_PIO
+};
+
+static nav_event_t nav_queue[NAV_QUEUE_SIZE];
+static volatile uint8_t nav_queue_head;
+static volatile uint8_t nav_queue_tail;
+
+/* debounced state, one bit per button */
+static uint8_t nav_queue_down;
+static uint8_t nav_queue_settling;
+static timer_tick_t nav_queue_edge[NAVSWITCH_NUM];
+
+
+/*
+ * Compare the switches against the debounced state and queue new presses,
+ * runs with interrupts off.
+ * @param polled - 1 when called from nav_queue_poll rather than the interrupt
+ */
+static void nav_queue_sample (bool polled)
+{
+    timer_tick_t now = timer_get ();
+    uint8_t held = 0;
+    uint8_t button, bit;
+
+    for (button = 0; button < NAVSWITCH_NUM; button++) {
+        if (!pio_input_get (pgm_read_byte (&nav_queue_pios[button]))) { // switches are active low, pio_t is a byte
+            held |= 1 << button;
+        }
+    }
+    RECORD_BUTTONS (held, polled);
+
+    for (button = 0; button < NAVSWITCH_NUM; button++) {
+        bit = 1 << button;
+        if (nav_queue_settling & bit) {
+            if ((timer_tick_t) (now - nav_queue_edge[button]) < NAV_QUEUE_DEBOUNCE) {
+                continue;
+            }
+            nav_queue_settling &= ~bit;
+        }
+        if ((held & bit) == (nav_queue_down & bit)) {
+            continue;
+        }
+        nav_queue_down ^= bit;
+        nav_queue_settling |= bit;
+        nav_queue_edge[button] = now;
+        if ((nav_queue_down & bit) && ((nav_queue_head - nav_queue_tail) & 0xFF) != NAV_QUEUE_SIZE) {
+            nav_queue[nav_queue_head & NAV_QUEUE_MASK].button = button;
+            nav_queue[nav_queue_head & NAV_QUEUE_MASK].time = now;
+            nav_queue_head++;
+        }
+    }
+}
+
+
+/*
+ * A navswitch pin has changed.
+ */
+ISR (PCINT1_vect)
+{
+    nav_queue_sample (0);
+}
+
+
+void nav_queue_init (void)
+{
+    nav_queue_head = nav_queue_tail = 0;
+    nav_queue_down = nav_queue_settling = 0;
+    PCMSK1 |= NAV_QUEUE_PCINTS;
+    PCICR |= _BV (PCIE1);
+    sei ();
+}
+
+
+void nav_queue_poll (void)
+{
+    cli ();
+    nav_queue_sample (1);
+    sei ();
+}
+
+
+bool nav_queue_get (nav_event_t* event)
+{
+    if (nav_queue_head == nav_queue_tail) {
+        return 0;
+    }
+    *event = nav_queue[nav_queue_tail & NAV_QUEUE_MASK];
+    nav_queue_tail++;
+    return 1;
+}
+
+
+uint8_t nav_queue_buttons (void)
+{
+    return nav_queue_down;
+}
@@ -0,0 +1,49 @@
+/** @file nav_queue.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief interrupt captured navswitch presses. A pin change interrupt
+ *  timestamps each press as the switch closes and queues it, so the game
+ *  sees every press in order however long a tick takes and however often
+ *  it looks.
+ */
+
+#ifndef NAV_QUEUE_H
+#define NAV_QUEUE_H
+
+#include "system.h"
+#include "timer.h"
+
+/* Must be a power of two. */
+#define NAV_QUEUE_SIZE 8
+
+typedef struct nav_event
+{
+    uint8_t button;       // NAVSWITCH_NORTH etc.
+    timer_tick_t time;    // timer count when the switch closed
+} nav_event_t;
+
+/*
+ * Enable the pin change interrupt, call after navswitch_init and sched_init.
+ */
+void nav_queue_init (void);
+
+/*
+ * Sample the switches, catches presses on pins without a pin change interrupt
+ * and ends debouncing. Call at least every timer wrap, the input task does.
+ */
+void nav_queue_poll (void);
+
+/*
+ * Take the oldest press off the queue.
+ * @param event - filled in with the press
+ * returns 0 when there are none
+ */
+bool nav_queue_get (nav_event_t* event);
+
+/*
+ * Buttons held down as of the last sample, after debouncing.
+ * returns bit n set while navswitch button n is down
+ */
+uint8_t nav_queue_buttons (void);
+
+#endif
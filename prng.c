@@ -0,0 +1,44 @@
+/** @file prng.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief small xorshift random number generator
+ */
+
+#include "system.h"
+#include "prng.h"
+
+/* Any non-zero start value, the generator never leaves zero. */
+#define PRNG_INIT 0xACE1
+
+/* 16 bits of state with the (7, 9, 8) shift triple runs through all 65535
+   non-zero states before repeating. An 8-bit xorshift would repeat after
+   255 draws, fewer than a match uses. The shifts by 8 and 9 are plain byte
+   moves on the AVR. */
+static prng_state_t prng_state = PRNG_INIT;
+
+
+void prng_seed (uint8_t seed)
+{
+    prng_state = PRNG_INIT ^ seed;
+}
+
+
+uint8_t prng_next (void)
+{
+    prng_state ^= prng_state << 7;
+    prng_state ^= prng_state >> 9;
+    prng_state ^= prng_state << 8;
+    return prng_state;
+}
+
+
+prng_state_t prng_save (void)
+{
+    return prng_state;
+}
+
+
+void prng_restore (prng_state_t state)
+{
+    prng_state = state ? state : PRNG_INIT;
+}
@@ -0,0 +1,39 @@
+/** @file prng.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief small xorshift random number generator for the ball's wind gusts.
+ *  Costs a handful of shifts and XORs per draw where avr-libc's rand()
+ *  needs a 32-bit divide, and its state can be saved and restored so a run
+ *  can be replayed exactly.
+ */
+
+#ifndef PRNG_H
+#define PRNG_H
+
+#include "system.h"
+
+typedef uint16_t prng_state_t;
+
+/*
+ * Start a new sequence.
+ * @param seed - any value, each one gives a different sequence
+ */
+void prng_seed (uint8_t seed);
+
+/*
+ * Next random byte, uniform over 0 to 255.
+ */
+uint8_t prng_next (void);
+
+/*
+ * Current state, pass it to prng_restore to repeat the draws from here.
+ */
+prng_state_t prng_save (void);
+
+/*
+ * Go back to a saved state.
+ * @param state - value from prng_save
+ */
+void prng_restore (prng_state_t state);
+
+#endif
@@ -0,0 +1,291 @@
+/** @file profile.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief per-tick loop budget profiler
+ */
+
+#ifdef PROFILE
+
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include "system.h"
+#include "timer.h"
+#include "ir_rx.h"
+#include "round.h"
+#include "scan.h"
+#include "stack.h"
+#include "text.h"
+#include "profile.h"
+
+#define PROFILE_TIME_DIGITS 10 // a uint32_t at its longest
+#define PROFILE_COUNT_DIGITS 5 // a uint16_t at its longest
+
+/* The longest piece is latency, three times with their separators, the
+   labels and the late count. The others have shorter labels or counts. */
+#define PROFILE_TEXT_SIZE (sizeof "LAT us LATE " + 3 * PROFILE_TIME_DIGITS + 2 + PROFILE_COUNT_DIGITS)
+
+/* no column waiting to be scanned for the press being timed */
+#define PROFILE_NO_COLUMN 0xFF
+
+/* The scheduler's timer counts in units of this many CPU cycles. Phases much
+   shorter than one count still average out correctly over many ticks as
+   they start at random points between counter edges. */
+#define PROFILE_CYCLES_PER_COUNT (F_CPU / TIMER_RATE)
+
+/* A stat's sum and count are halved together before the count reaches this,
+   so the sum of times below 65536 counts always fits 32 bits and the
+   average's remainder scales to cycles without overflowing. The average is
+   then over the last 32768 or more measurements. */
+#define PROFILE_COUNT_MAX 0xFFFF
+
+/*
+ * Running stats for one phase, times in timer counts
+ */
+typedef struct profile_stat
+{
+    timer_tick_t min;
+    timer_tick_t max;
+    uint32_t sum;
+    uint16_t count;
+} profile_stat_t;
+
+#define PROFILE_NAME_SIZE 5
+
+static const char profile_names[PROFILE_NUM_PHASES][PROFILE_NAME_SIZE] PROGMEM = {"IN", "BALL", "LINK", "DSP", "TICK"};
+
+static profile_stat_t profile_stats[PROFILE_NUM_PHASES];
+static timer_tick_t profile_budget;
+static timer_tick_t profile_tick_time;
+static timer_tick_t profile_phase_time;
+static bool profile_running;
+static uint16_t profile_missed;
+static profile_stat_t profile_latency;    // only the scan interrupt writes these two once timing
+static uint16_t profile_late;
+static timer_tick_t profile_edge_time;
+static volatile bool profile_timing;         // also read by the scan interrupt
+static uint8_t profile_latency_want;             // column the timed press changes
+static volatile uint8_t profile_latency_column;  // it once pushed to the scan
+static profile_stat_t profile_scan_stat; // only the scan interrupt writes these two
+static uint16_t profile_scan_over;
+static char profile_text[PROFILE_TEXT_SIZE];
+
+
+void profile_init (uint16_t loop_rate)
+{
+    uint8_t i;
+
+    for (i = 0; i < PROFILE_NUM_PHASES; i++) {
+        profile_stats[i].min = ~0;
+        profile_stats[i].max = 0;
+        profile_stats[i].sum = 0;
+        profile_stats[i].count = 0;
+    }
+    profile_budget = TIMER_RATE / loop_rate;
+    profile_missed = 0;
+    profile_running = 0;
+    profile_latency.min = ~0;
+    profile_latency.max = 0;
+    profile_latency.sum = 0;
+    profile_latency.count = 0;
+    profile_timing = 0;
+    profile_late = 0;
+    profile_scan_stat.min = ~0;
+    profile_scan_stat.max = 0;
+    profile_scan_stat.sum = 0;
+    profile_scan_stat.count = 0;
+    profile_scan_over = 0;
+}
+
+
+/*
+ * Add one measurement to a phase's stats.
+ */
+static void profile_record (profile_stat_t* stat, timer_tick_t time)
+{
+    if (stat->count == PROFILE_COUNT_MAX) {
+        stat->sum >>= 1;
+        stat->count >>= 1;
+    }
+    if (time < stat->min) {
+        stat->min = time;
+    }
+    if (time > stat->max) {
+        stat->max = time;
+    }
+    stat->sum += time;
+    stat->count++;
+}
+
+
+void profile_tick_start (void)
+{
+    timer_tick_t now = timer_get ();
+    timer_tick_t work;
+
+    if (profile_running) {
+        work = profile_phase_time - profile_tick_time;
+        profile_record (&profile_stats[PROFILE_TICK], work);
+        if (work > profile_budget) {
+            profile_missed++;
+        }
+    }
+    profile_running = 1;
+    profile_tick_time = profile_phase_time = now;
+}
+
+
+void profile_phase_end (profile_phase_t phase)
+{
+    timer_tick_t now = timer_get ();
+
+    profile_record (&profile_stats[phase], now - profile_phase_time);
+    profile_phase_time = now;
+}
+
+
+void profile_latency_start (timer_tick_t edge, uint8_t col)
+{
+    if (profile_timing) {
+        return;
+    }
+    profile_edge_time = edge;
+    profile_latency_want = col;
+    profile_latency_column = PROFILE_NO_COLUMN;
+    profile_timing = 1;
+}
+
+
+void profile_latency_pushed (uint8_t col)
+{
+    if (profile_timing && col == profile_latency_want) {
+        profile_latency_column = col;
+    }
+}
+
+
+/*
+ * Runs in the scan interrupt. A press should show within one loop period for
+ * the game to act on it and one scan across the LEDs.
+ */
+void profile_latency_shown (uint8_t col)
+{
+    timer_tick_t latency;
+
+    if (!profile_timing || col != profile_latency_column) {
+        return;
+    }
+    latency = timer_get () - profile_edge_time;
+    profile_record (&profile_latency, latency);
+    if (latency > profile_budget + SCAN_FRAME_TIME) {
+        profile_late++;
+    }
+    profile_timing = 0;
+}
+
+
+void profile_latency_cancel (void)
+{
+    profile_timing = 0;
+}
+
+
+/*
+ * Runs in the scan interrupt, the time from the compare match counts any
+ * wait behind other interrupts as the game loses that time too.
+ */
+void profile_scan (timer_tick_t due)
+{
+    timer_tick_t time = timer_get () - due;
+
+    profile_record (&profile_scan_stat, time);
+    if (time > SCAN_BUDGET) {
+        profile_scan_over++;
+    }
+}
+
+
+/*
+ * Convert timer counts to microseconds.
+ */
+static uint32_t profile_us (uint32_t counts)
+{
+    return counts * PROFILE_CYCLES_PER_COUNT / (F_CPU / 1000000);
+}
+
+
+/*
+ * Append a stat's min/avg/max, '-' if nothing has been measured.
+ * @param scale - converts timer counts to what is shown, cycles or microseconds
+ */
+static char* profile_append_stat (char* pos, const profile_stat_t* stat, uint32_t (*scale)(uint32_t))
+{
+    if (!stat->count) {
+        *pos++ = '-';
+        return pos;
+    }
+    pos = text_append_number (pos, scale (stat->min));
+    *pos++ = '/';
+    pos = text_append_number (pos, scale (stat->sum / stat->count)
+                                   + scale (stat->sum % stat->count) / stat->count); // keeps what is below one count
+    *pos++ = '/';
+    return text_append_number (pos, scale (stat->max));
+}
+
+
+/*
+ * Convert timer counts to CPU cycles.
+ */
+static uint32_t profile_cycles (uint32_t counts)
+{
+    return counts * PROFILE_CYCLES_PER_COUNT;
+}
+
+
+const char* profile_report (uint8_t piece)
+{
+    char* pos = profile_text;
+    profile_stat_t stat;
+    uint16_t count;
+
+    if (piece < PROFILE_NUM_PHASES) {
+        pos = text_append_P (pos, profile_names[piece]);
+        *pos++ = ' ';
+        pos = profile_append_stat (pos, &profile_stats[piece], profile_cycles);
+        if (piece == PROFILE_TICK) {
+            pos = text_append_P (pos, PSTR (" MISS "));
+            pos = text_append_number (pos, profile_missed);
+        }
+    } else if (piece == PROFILE_NUM_PHASES) {
+        cli (); // the scan interrupt could land half way through a copy
+        stat = profile_latency;
+        count = profile_late;
+        sei ();
+        pos = text_append_P (pos, PSTR ("LAT "));
+        pos = profile_append_stat (pos, &stat, profile_us);
+        if (stat.count) {
+            pos = text_append_P (pos, PSTR ("us"));
+        }
+        pos = text_append_P (pos, PSTR (" LATE "));
+        pos = text_append_number (pos, count);
+    } else if (piece == PROFILE_NUM_PHASES + 1) {
+        cli ();
+        stat = profile_scan_stat;
+        count = profile_scan_over;
+        sei ();
+        pos = text_append_P (pos, PSTR ("SCAN "));
+        pos = profile_append_stat (pos, &stat, profile_cycles);
+        pos = text_append_P (pos, PSTR (" OVER "));
+        pos = text_append_number (pos, count);
+    } else {
+        pos = text_append_P (pos, PSTR ("RXOVF "));
+        pos = text_append_number (pos, ir_rx_overflows ());
+        pos = text_append_P (pos, PSTR (" ILLEGAL "));
+        pos = text_append_number (pos, round_illegal ());
+        pos = text_append_P (pos, PSTR (" STACK "));
+        pos = text_append_number (pos, stack_unused ());
+    }
+    *pos = '\0';
+    return profile_text;
+}
+
+#endif
@@ -0,0 +1,124 @@
+/** @file profile.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief per-tick loop budget profiler, only built in when PROFILE is defined
+ *  (make PROFILE=1). The scheduler marks the start of each wake that runs
+ *  tasks, each task marks the end of its phase and the profiler keeps
+ *  min/avg/max cycles per phase and counts wakes whose work did not fit in
+ *  one period of the fastest task. It also times catcher paddle moves from
+ *  the switch closing to the scan interrupt driving the paddle's new
+ *  position onto the LEDs, and each scan interrupt from its compare match
+ *  to returning against the scan's budget.
+ */
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include "system.h"
+#include "timer.h"
+
+typedef enum profile_phase
+{
+    PROFILE_INPUT,      // navswitch scan and what the player pressed
+    PROFILE_BALL,       // ball physics
+    PROFILE_LINK,       // IR messages and round changes
+    PROFILE_DISPLAY,    // frame_flush and tinygl_update
+    PROFILE_TICK,       // whole wake, first task start to end of last phase
+    PROFILE_NUM_PHASES
+} profile_phase_t;
+
+/* the report comes a piece at a time, one for each phase with the missed
+   deadlines after TICK's, then latency, scan and the counts */
+#define PROFILE_NUM_PIECES (PROFILE_NUM_PHASES + 3)
+
+#ifdef PROFILE
+
+#define PROFILE_INIT(rate) profile_init (rate)
+#define PROFILE_TICK_START() profile_tick_start ()
+#define PROFILE_PHASE_END(phase) profile_phase_end (phase)
+#define PROFILE_LATENCY_START(edge, col) profile_latency_start (edge, col)
+#define PROFILE_LATENCY_PUSHED(col) profile_latency_pushed (col)
+#define PROFILE_LATENCY_SHOWN(col) profile_latency_shown (col)
+#define PROFILE_LATENCY_CANCEL() profile_latency_cancel ()
+#define PROFILE_SCAN(due) profile_scan (due)
+
+#else
+
+#define PROFILE_INIT(rate) ((void) 0)
+#define PROFILE_TICK_START() ((void) 0)
+#define PROFILE_PHASE_END(phase) ((void) 0)
+#define PROFILE_LATENCY_START(edge, col) ((void) 0)
+#define PROFILE_LATENCY_PUSHED(col) ((void) 0)
+#define PROFILE_LATENCY_SHOWN(col) ((void) 0)
+#define PROFILE_LATENCY_CANCEL() ((void) 0)
+#define PROFILE_SCAN(due) ((void) 0)
+
+#endif
+
+/*
+ * Start the profiler, must come after sched_init as it shares its timer.
+ * @param loop_rate - rate of the fastest task in Hz, sets the tick budget
+ */
+void profile_init (uint16_t loop_rate);
+
+/*
+ * Mark the start of a tick, the scheduler calls this when it wakes with
+ * tasks due. Also closes the previous tick and counts it as missed if it ran
+ * over budget.
+ */
+void profile_tick_start (void);
+
+/*
+ * Mark the end of a phase, its time runs from the previous mark.
+ * @param phase - phase that just finished
+ */
+void profile_phase_end (profile_phase_t phase);
+
+/*
+ * Start timing a switch press the game is acting on, ignored while the
+ * previous press is still being timed.
+ * @param edge - timer count when the switch closed
+ * @param col - column the press changes, other columns changing do not end
+ * the timing
+ */
+void profile_latency_start (timer_tick_t edge, uint8_t col);
+
+/*
+ * A changed column has just been handed to the scan.
+ * @param col - column that changed
+ */
+void profile_latency_pushed (uint8_t col);
+
+/*
+ * The scan interrupt has just driven a column onto the LEDs, ends the timing
+ * if it is the one the press changed.
+ * @param col - column being scanned
+ */
+void profile_latency_shown (uint8_t col);
+
+/*
+ * Stop timing the press, the screen it changed has been cleared.
+ */
+void profile_latency_cancel (void);
+
+/*
+ * The scan interrupt is about to return, counts it as over budget if it
+ * took more than SCAN_BUDGET.
+ * @param due - timer count its compare matched at
+ */
+void profile_scan (timer_tick_t due);
+
+/*
+ * Format one piece of the stats as scrolling text, "IN min/avg/max" in
+ * cycles for each phase with the missed deadline count after TICK's,
+ * "LAT min/avg/max" switch to LED latency in microseconds with the count of
+ * presses that took over a loop period and a whole ledmat frame,
+ * "SCAN min/avg/max" cycles per scan interrupt with the count over budget,
+ * then IR receive overflows, round events with no move from their state and
+ * the bytes of RAM the stack has never reached. Times with nothing measured
+ * yet show as '-', averages are over at least the last 32768 measurements.
+ * @param piece - which piece, below PROFILE_NUM_PIECES
+ * returns a static buffer, overwritten by the next call
+ */
+const char* profile_report (uint8_t piece);
+#endif
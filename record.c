@@ -0,0 +1,207 @@
+/** @file record.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief match recorder
+ */
+
+#ifdef RECORD
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/eeprom.h>
+#include "system.h"
+#include "timer.h"
+#include "record.h"
+
+/* Must be a power of two. Received IR bytes log two bytes each, twice as
+   fast as the EEPROM takes them, so the buffer fills by about half of what
+   arrives. The other board sending its whole window again, 8 frames of up
+   to 18 bytes, fills a little over 128. */
+#define RECORD_BUFFER_SIZE 256
+#define RECORD_BUFFER_MASK (RECORD_BUFFER_SIZE - 1)
+
+/* Bytes written between commits of the log length. */
+#define RECORD_BATCH 32
+
+#define RECORD_ENTRY_MAX 5
+#define RECORD_DELTA_MAX 0xFFFFFFUL
+#define RECORD_CAPACITY (E2END + 1 - RECORD_HEADER_SIZE)
+
+#define RECORD_ADDRESS(offset) ((uint8_t*) (uintptr_t) (offset))
+
+static uint8_t record_buffer[RECORD_BUFFER_SIZE];
+static uint16_t record_head;
+static uint16_t record_tail;
+static uint16_t record_accepted;  // entry bytes taken into the log
+static uint16_t record_written;   // entry bytes in the EEPROM
+static uint8_t record_commit;     // length bytes still to write
+static bool record_stopped;
+
+static uint32_t record_count;     // timer count without wrapping
+static timer_tick_t record_timer;
+static uint32_t record_tick_count;
+static uint32_t record_last[RECORD_NUM_KINDS];
+static uint8_t record_mask;
+
+
+/*
+ * Timer count without wrapping, runs with interrupts off. Ticks come far
+ * more often than the timer wraps.
+ */
+static uint32_t record_now (void)
+{
+    timer_tick_t now = timer_get ();
+
+    record_count += (timer_tick_t) (now - record_timer);
+    record_timer = now;
+    return record_count;
+}
+
+
+/*
+ * Time of something an interrupt has seen, in half counts.
+ */
+static uint32_t record_isr_time (void)
+{
+    uint32_t count = record_now ();
+
+    return 2 * count + (count == record_tick_count);
+}
+
+
+/*
+ * Encode an entry into the buffer, runs with interrupts off.
+ */
+static void record_entry (record_kind_t kind, uint32_t time, uint8_t data)
+{
+    uint8_t entry[RECORD_ENTRY_MAX];
+    uint32_t delta = time - record_last[kind];
+    uint8_t length = 1;
+    uint8_t i;
+
+    if (record_stopped) {
+        return;
+    }
+    if (kind == RECORD_RX) {
+        delta = delta > RECORD_RX_GAP ? delta - RECORD_RX_GAP : 0;
+    }
+    if (delta > RECORD_DELTA_MAX) {
+        delta = RECORD_DELTA_MAX; // minutes of nothing, the replay only loses the wait
+    }
+    if (delta < RECORD_SHORT) {
+        entry[0] = kind << RECORD_KIND_SHIFT | delta;
+    } else {
+        for (i = 0; delta >> (8 * i); i++) {
+            entry[length++] = delta >> (8 * i);
+        }
+        entry[0] = kind << RECORD_KIND_SHIFT | (RECORD_SHORT - 1 + i);
+    }
+    entry[length++] = data;
+
+    if (RECORD_BUFFER_SIZE - (uint16_t) (record_head - record_tail) < length
+        || record_accepted + length > RECORD_CAPACITY) {
+        record_stopped = 1; // anything after a gap could not be replayed
+        return;
+    }
+    for (i = 0; i < length; i++) {
+        record_buffer[record_head++ & RECORD_BUFFER_MASK] = entry[i];
+    }
+    record_accepted += length;
+    EECR |= _BV (EERIE);
+    // where the replay will put it, which the clamping above may have moved
+    record_last[kind] += delta + (kind == RECORD_RX ? RECORD_RX_GAP : 0);
+}
+
+
+void record_init (void)
+{
+    uint8_t i;
+
+    record_head = record_tail = 0;
+    record_accepted = record_written = 0;
+    record_commit = 0;
+    record_stopped = 0;
+    record_count = record_timer = timer_get (); // early enough not to have wrapped
+    record_tick_count = ~0;
+    for (i = 0; i < RECORD_NUM_KINDS; i++) {
+        record_last[i] = 0;
+    }
+    record_mask = 0;
+    EECR &= ~_BV (EERIE);
+    eeprom_update_byte (RECORD_ADDRESS (0), 'R');
+    eeprom_update_byte (RECORD_ADDRESS (1), 'L');
+    eeprom_update_byte (RECORD_ADDRESS (2), 0);
+    eeprom_update_byte (RECORD_ADDRESS (3), 0);
+}
+
+
+/*
+ * The EEPROM is free, write it the next byte. The length goes in once a
+ * batch is in or the buffer has emptied, and the interrupt goes off once
+ * there is nothing left to write.
+ */
+ISR (EE_READY_vect)
+{
+    if (record_commit) { // low byte first, so a log cut off between the two is only short
+        record_commit--;
+        eeprom_update_byte (RECORD_ADDRESS (3 - record_commit), record_written >> (8 * (1 - record_commit)));
+        return;
+    }
+    if (record_head == record_tail) {
+        EECR &= ~_BV (EERIE);
+        return;
+    }
+    eeprom_update_byte (RECORD_ADDRESS (RECORD_HEADER_SIZE + record_written),
+                        record_buffer[record_tail++ & RECORD_BUFFER_MASK]);
+    record_written++;
+    if (record_written % RECORD_BATCH == 0 || record_head == record_tail) {
+        record_commit = 2;
+    }
+}
+
+
+void record_tick (void)
+{
+    cli ();
+    record_tick_count = record_now ();
+    sei ();
+}
+
+
+void record_buttons (uint8_t mask, bool polled)
+{
+    if (mask == record_mask) {
+        return;
+    }
+    record_mask = mask;
+    if (polled) { // the change came before this tick, replay it just ahead of it
+        uint32_t count = record_now ();
+        record_entry (RECORD_NAV, count ? 2 * count - 1 : 0, mask);
+    } else {
+        record_entry (RECORD_NAV, record_isr_time (), mask);
+    }
+}
+
+
+void record_rx (uint8_t byte)
+{
+    record_entry (RECORD_RX, record_isr_time (), byte);
+}
+
+
+void record_tx (uint8_t crc)
+{
+    cli ();
+    record_entry (RECORD_TX, 2 * record_now () + 1, crc);
+    sei ();
+}
+
+
+void record_seed (uint8_t seed)
+{
+    cli ();
+    record_entry (RECORD_SEED, 2 * record_now () + 1, seed);
+    sei ();
+}
+
+#endif
@@ -0,0 +1,106 @@
+/** @file record.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief match recorder, only built in when RECORD is defined
+ *  (make RECORD=1). Navswitch changes and IR bytes received are logged with
+ *  the timer count they happened at, along with the check byte of every
+ *  frame sent and every wind gust seed. Entries go into a RAM buffer that
+ *  the EEPROM ready interrupt writes out a byte at a time, as fast as the
+ *  EEPROM takes them, committing the log length after each batch. The host simulator can feed
+ *  a log back into a board and check it logs the same again (game_sim -r).
+ *
+ *  EEPROM layout: 'R', 'L', the committed length of the entries in bytes
+ *  (little endian), then the entries. An entry is a header byte with the
+ *  kind in its top 3 bits, 0 to 3 bytes of time and one data byte.
+ *
+ *  Times are in half timer counts from power on, twice the count plus 1 for
+ *  anything that happened after the tick at that count had started. Each
+ *  kind counts from its own previous entry, and IR bytes from one IR byte
+ *  time after the last, so the bytes of a frame fit in the header. A header
+ *  below RECORD_SHORT has the time in its low 5 bits, RECORD_SHORT - 1 + n
+ *  means it follows in n little endian bytes. Recording stops for good at
+ *  the first entry that does not fit, so a log is always a clean start of a
+ *  match. The funkit's 1 KB EEPROM holds the first 12 to 24 seconds of a
+ *  match, about half of it.
+ */
+
+#ifndef RECORD_H
+#define RECORD_H
+
+#include "system.h"
+
+#define RECORD_KIND_SHIFT 5
+#define RECORD_SHORT 24
+#define RECORD_HEADER_SIZE 4
+
+/* Half timer counts in one IR byte at 2400 baud with start and stop bits,
+   less a little so it never goes negative. */
+#define RECORD_RX_GAP 256
+
+typedef enum record_kind
+{
+    RECORD_NAV,     // buttons held, bit n for navswitch button n
+    RECORD_RX,      // IR byte received
+    RECORD_TX,      // CRC of an IR frame sent
+    RECORD_SEED,    // wind gust seed
+    RECORD_NUM_KINDS
+} record_kind_t;
+
+#ifdef RECORD
+
+#define RECORD_INIT() record_init ()
+#define RECORD_TICK() record_tick ()
+#define RECORD_BUTTONS(mask, polled) record_buttons (mask, polled)
+#define RECORD_RX_BYTE(byte) record_rx (byte)
+#define RECORD_TX_FRAME(crc) record_tx (crc)
+#define RECORD_SEED_USED(seed) record_seed (seed)
+
+#else
+
+#define RECORD_INIT() ((void) 0)
+#define RECORD_TICK() ((void) 0)
+#define RECORD_BUTTONS(mask, polled) ((void) (polled))
+#define RECORD_RX_BYTE(byte) ((void) 0)
+#define RECORD_TX_FRAME(crc) ((void) 0)
+#define RECORD_SEED_USED(seed) ((void) 0)
+
+#endif
+
+/*
+ * Start a new log over the last one, call after sched_init and before any
+ * interrupt that records. Blocks for the few header bytes.
+ */
+void record_init (void);
+
+/*
+ * Mark the start of a tick, the scheduler calls this when it wakes with
+ * tasks due.
+ */
+void record_tick (void);
+
+/*
+ * Log the buttons held when they change, runs with interrupts off.
+ * @param mask - bit n set while navswitch button n is down
+ * @param polled - 1 when a task found the change rather than the pin change interrupt
+ */
+void record_buttons (uint8_t mask, bool polled);
+
+/*
+ * Log an IR byte from the receive interrupt.
+ * @param byte - byte received
+ */
+void record_rx (uint8_t byte);
+
+/*
+ * Log a frame the game has sent.
+ * @param crc - the frame's check byte, which covers everything in it
+ */
+void record_tx (uint8_t crc);
+
+/*
+ * Log a wind gust seed.
+ * @param seed - value passed to prng_seed
+ */
+void record_seed (uint8_t seed);
+
+#endif
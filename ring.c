@@ -0,0 +1,207 @@
+/** @file ring.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief any number of funkits sat in a ring
+ */
+
+#ifdef RING
+
+#include <string.h>
+#include "system.h"
+#include "timer.h"
+#include "message.h"
+#include "level.h"
+#include "stack.h"
+#include "ring.h"
+
+/* table frame layout */
+#define RING_TABLE_HOPS 0
+#define RING_TABLE_LAST 1
+#define RING_TABLE_CAUGHT 2
+#define RING_TABLE_BEST 3
+#define RING_TABLE_BEST_COUNT 4
+#define RING_TABLE_ROUNDS 5
+
+/* token frame layout */
+#define RING_TOKEN_HOPS 0
+#define RING_TOKEN_ROUND 1
+#define RING_TOKEN_CLAIM 2 // two bytes, little endian
+#define RING_TOKEN_LEVEL 4
+#define RING_TOKEN_BOARD 5 // two bytes, little endian
+
+/* best token seen this match */
+static bool ring_seen;
+static uint8_t ring_round;
+static uint16_t ring_claim;
+static uint16_t ring_board;
+
+/* the last token and table this board sent or passed on, kept until the
+   window has room for them */
+static uint8_t ring_token_out[RING_TOKEN_SIZE];
+static uint8_t ring_table_out[RING_TABLE_SIZE];
+static bool ring_token_due;
+static bool ring_table_due;
+
+
+void ring_reset (void)
+{
+    ring_seen = 0;
+    ring_token_due = 0; // the last table of the last match may still be on its way
+}
+
+
+void ring_flush (void)
+{
+    if (ring_token_due) {
+        ring_token_due = !message_send (MESSAGE_TOKEN, ring_token_out, RING_TOKEN_SIZE);
+    }
+    if (ring_table_due) {
+        ring_table_due = !message_send (MESSAGE_TABLE, ring_table_out, RING_TABLE_SIZE);
+    }
+}
+
+
+/*
+ * Send a token, or keep it until ring_flush finds room for it. A token only
+ * goes out if it beats any sent before, so it replaces one still waiting.
+ */
+static void ring_token_post (const uint8_t* payload)
+{
+    memcpy (ring_token_out, payload, RING_TOKEN_SIZE);
+    ring_token_due = 1;
+    ring_flush ();
+}
+
+
+/*
+ * Send a table, or keep it until ring_flush finds room for it. A later
+ * table has every round of an earlier one, so it replaces one still waiting.
+ */
+static void ring_table_post (const uint8_t* payload)
+{
+    memcpy (ring_table_out, payload, RING_TABLE_SIZE);
+    ring_table_due = 1;
+    ring_flush ();
+}
+
+
+void ring_token_send (uint8_t round)
+{
+    uint8_t payload[RING_TOKEN_SIZE];
+
+    ring_seen = 1;
+    ring_round = round;
+    ring_claim = timer_get ();
+    ring_board = stack_noise ();
+    payload[RING_TOKEN_HOPS] = 0;
+    payload[RING_TOKEN_ROUND] = round;
+    payload[RING_TOKEN_CLAIM] = ring_claim & 0xFF;
+    payload[RING_TOKEN_CLAIM + 1] = ring_claim >> 8;
+    payload[RING_TOKEN_LEVEL] = level_get ();
+    payload[RING_TOKEN_BOARD] = ring_board & 0xFF;
+    payload[RING_TOKEN_BOARD + 1] = ring_board >> 8;
+    ring_token_post (payload);
+}
+
+
+/*
+ * A later round beats an earlier one, then the earlier count wins and then
+ * the lower board word, so two boards taking the token on the same count
+ * still agree on one. This board's own token coming back round is no better
+ * than itself.
+ */
+static bool ring_token_better (uint8_t round, uint16_t claim, uint16_t board)
+{
+    if (!ring_seen || round > ring_round) {
+        return 1;
+    }
+    if (round != ring_round) {
+        return 0;
+    }
+    return claim < ring_claim || (claim == ring_claim && board < ring_board);
+}
+
+
+uint8_t ring_token_take (void)
+{
+    uint8_t payload[MESSAGE_PAYLOAD_MAX];
+    uint16_t claim;
+    uint16_t board;
+
+    if (!message_waiting (MESSAGE_TOKEN, payload)) {
+        return RING_TOKEN_NONE;
+    }
+    if (ring_seen && payload[RING_TOKEN_ROUND] < ring_round) {
+        return RING_TOKEN_NONE; // the next match's, which waits for ring_reset
+    }
+    message_take (MESSAGE_TOKEN, NULL);
+    claim = payload[RING_TOKEN_CLAIM] | (uint16_t) payload[RING_TOKEN_CLAIM + 1] << 8;
+    board = payload[RING_TOKEN_BOARD] | (uint16_t) payload[RING_TOKEN_BOARD + 1] << 8;
+    if (!ring_token_better (payload[RING_TOKEN_ROUND], claim, board)) {
+        return RING_TOKEN_NONE;
+    }
+    ring_seen = 1;
+    ring_round = payload[RING_TOKEN_ROUND];
+    ring_claim = claim;
+    ring_board = board;
+    level_set (payload[RING_TOKEN_LEVEL]); // every board plays at the level of the first to push
+    payload[RING_TOKEN_HOPS]++;
+    ring_token_post (payload);
+    return payload[RING_TOKEN_HOPS] == 1 ? RING_TOKEN_CATCH : RING_TOKEN_WATCH;
+}
+
+
+void ring_table_add (ring_table_t* table, uint8_t caught)
+{
+    if (!table->best_count || caught > table->best) {
+        table->best = caught;
+        table->best_count = 1;
+    } else if (caught == table->best) {
+        table->best_count++;
+    }
+    table->rounds++;
+}
+
+
+void ring_table_send (const ring_table_t* table, uint8_t caught, bool last)
+{
+    uint8_t payload[RING_TABLE_SIZE];
+
+    payload[RING_TABLE_HOPS] = 0;
+    payload[RING_TABLE_LAST] = last;
+    payload[RING_TABLE_CAUGHT] = caught;
+    payload[RING_TABLE_BEST] = table->best;
+    payload[RING_TABLE_BEST_COUNT] = table->best_count;
+    payload[RING_TABLE_ROUNDS] = table->rounds;
+    ring_table_post (payload);
+}
+
+
+bool ring_table_take (ring_table_t* table, bool shooter, bool* last)
+{
+    uint8_t payload[MESSAGE_PAYLOAD_MAX];
+
+    if (!message_take (MESSAGE_TABLE, payload)) {
+        return 0;
+    }
+    table->best = payload[RING_TABLE_BEST];
+    table->best_count = payload[RING_TABLE_BEST_COUNT];
+    table->rounds = payload[RING_TABLE_ROUNDS];
+    *last = payload[RING_TABLE_LAST];
+    if (!shooter) {
+        payload[RING_TABLE_HOPS]++;
+        ring_table_post (payload);
+    }
+    return 1;
+}
+
+
+int8_t ring_result (const ring_table_t* table, uint8_t caught)
+{
+    if (caught < table->best) {
+        return -1;
+    }
+    return table->best_count == 1 ? 1 : 0;
+}
+
+#endif
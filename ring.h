@@ -0,0 +1,119 @@
+/** @file ring.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief any number of funkits sat in a ring, only built in when RING is
+ *  defined (make RING=1, every board built the same way). Each board's IR
+ *  LED faces the next board downstream, so a frame only ever reaches that
+ *  one board and anything the whole ring must hear is passed on board by
+ *  board. Two boards facing each other are a ring of two.
+ *
+ *  The board holding the token is the shooter and the board downstream of it
+ *  catches, the ball, tick and path frames go straight between the two as in
+ *  the two player game and every other board watches. The first board to
+ *  push takes the token. Boards pushing before word of another's token
+ *  reaches them each make one, stamped with the round, the timer count it
+ *  was taken at and the taker's stack_noise() word, and the lowest count
+ *  wins, or the lowest word when two were taken on the same count: a token
+ *  meeting a board that has seen a better one goes no further, and a holder
+ *  that sees a better one gives its own up. A token carries the level its
+ *  taker picked and every board that follows it plays at that level.
+ *
+ *  At the end of its round the catcher adds its catches to the table, sends
+ *  the table round the ring and takes the token itself, so every board
+ *  shoots once and catches once. The table stops at the shooter it started
+ *  next to and holds only the best round and how many catchers matched it,
+ *  so frames stay the same size however many boards there are and no board
+ *  keeps anything per board. The match ends when the token comes back to the
+ *  board that took it first, which sends the table round one last time for
+ *  every board to find out whether its round was the best.
+ */
+
+#ifndef RING_H
+#define RING_H
+
+#include "system.h"
+
+#define RING_TOKEN_SIZE 7 // [bytes] boards passed through, round, the count it was taken at, the level and the taker's word
+#define RING_TABLE_SIZE 6 // [bytes] hops, last, round's catches then the table
+
+/* what a token frame meant for this board */
+#define RING_TOKEN_NONE 0
+#define RING_TOKEN_CATCH 1  // the board upstream has taken it, this one catches
+#define RING_TOKEN_WATCH 2  // a board further up has taken it, passed on
+
+/*
+ * Scores so far, kept by every board from the last table to pass by.
+ * best: most balls caught in one round
+ * best_count: catchers who caught that many
+ * rounds: rounds over this match
+ */
+typedef struct ring_table_s
+{
+    uint8_t best;
+    uint8_t best_count;
+    uint8_t rounds;
+} ring_table_t;
+
+/*
+ * Forget the last match's token, call as the start screen comes up.
+ */
+void ring_reset (void);
+
+/*
+ * Send the token or table that last found the window full, call every
+ * tick the link is serviced.
+ */
+void ring_flush (void);
+
+/*
+ * Take the token, tells the board downstream to catch.
+ * @param round - rounds over this match, a later round's token beats any before
+ */
+void ring_token_send (uint8_t round);
+
+/*
+ * Take a token frame if one has arrived, a better token than any seen this
+ * match is passed on and followed, even if this board holds one, and
+ * anything else goes no further. Tokens come round in round order, so one
+ * from an earlier round than this match has reached is the next match's,
+ * and it is left in its mailbox until ring_reset.
+ * returns RING_TOKEN_CATCH or RING_TOKEN_WATCH for a better token, which
+ * also means this board no longer holds one, otherwise RING_TOKEN_NONE
+ */
+uint8_t ring_token_take (void);
+
+/*
+ * Count a finished round into the table.
+ * @param table - table so far
+ * @param caught - balls the round's catcher caught
+ */
+void ring_table_add (ring_table_t* table, uint8_t caught);
+
+/*
+ * Start the table round the ring at the end of this board's round as
+ * catcher.
+ * @param table - table with the round added
+ * @param caught - balls caught this round
+ * @param last - 1 if the match is over
+ */
+void ring_table_send (const ring_table_t* table, uint8_t caught, bool last);
+
+/*
+ * Take a table frame if one has arrived and pass it on unless this board
+ * shot the round it is about, where it stops.
+ * @param table - overwritten with the table
+ * @param shooter - 1 if this board was the round's shooter
+ * @param last - set to 1 if the match is over
+ * returns 1 if a table arrived
+ */
+bool ring_table_take (ring_table_t* table, bool shooter, bool* last);
+
+/*
+ * How this board did, from its own catches and the final table.
+ * @param table - table after the last round
+ * @param caught - balls this board caught in its round
+ * returns 1 won, 0 tied or -1 lost
+ */
+int8_t ring_result (const ring_table_t* table, uint8_t caught);
+
+#endif
@@ -0,0 +1,85 @@
+/** @file round.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief the round's state machine
+ */
+
+#include <avr/pgmspace.h>
+#include "system.h"
+#include "round.h"
+
+/* Table entries are the next state plus one, so the zero a missing entry
+   gets is no move. */
+#define ROUND_TO(state) ((state) + 1)
+#define ROUND_NO_MOVE 0
+
+static const uint8_t round_table[ROUND_NUM_STATES][ROUND_NUM_EVENTS] PROGMEM = {
+    [ROUND_SELECT] = {
+        [ROUND_EVENT_SHOOT] = ROUND_TO (ROUND_AIM),
+        [ROUND_EVENT_CATCH] = ROUND_TO (ROUND_HANDOFF),
+        [ROUND_EVENT_WATCH] = ROUND_TO (ROUND_WATCH),
+    },
+    [ROUND_AIM] = {
+        [ROUND_EVENT_CATCH] = ROUND_TO (ROUND_HANDOFF),      // a RING shooter giving up its token
+        [ROUND_EVENT_WATCH] = ROUND_TO (ROUND_WATCH),
+        [ROUND_EVENT_FIRE] = ROUND_TO (ROUND_IN_FLIGHT),
+        [ROUND_EVENT_LOADED] = ROUND_TO (ROUND_AIM),         // MULTI_BALL balls leaving while another is loaded
+        [ROUND_EVENT_SCORE] = ROUND_TO (ROUND_SCORE_SYNC),
+        [ROUND_EVENT_OVER] = ROUND_TO (ROUND_GAME_OVER),     // a RING table back round to the last shooter
+    },
+    [ROUND_IN_FLIGHT] = {
+        [ROUND_EVENT_CATCH] = ROUND_TO (ROUND_HANDOFF),
+        [ROUND_EVENT_WATCH] = ROUND_TO (ROUND_WATCH),
+        [ROUND_EVENT_LOADED] = ROUND_TO (ROUND_AIM),
+        [ROUND_EVENT_SCORE] = ROUND_TO (ROUND_SCORE_SYNC),
+        [ROUND_EVENT_OVER] = ROUND_TO (ROUND_GAME_OVER),
+    },
+    [ROUND_HANDOFF] = {
+        [ROUND_EVENT_WATCH] = ROUND_TO (ROUND_WATCH),
+        [ROUND_EVENT_ARRIVED] = ROUND_TO (ROUND_CATCHING),
+        [ROUND_EVENT_ALL_IN] = ROUND_TO (ROUND_SCORE_SYNC),
+    },
+    [ROUND_CATCHING] = {
+        [ROUND_EVENT_WATCH] = ROUND_TO (ROUND_WATCH),
+        [ROUND_EVENT_ARRIVED] = ROUND_TO (ROUND_CATCHING),   // MULTI_BALL balls arriving while others fly
+        [ROUND_EVENT_GONE] = ROUND_TO (ROUND_HANDOFF),
+        [ROUND_EVENT_ALL_IN] = ROUND_TO (ROUND_SCORE_SYNC),  // the last ball still in the paddle's column
+    },
+    [ROUND_SCORE_SYNC] = {
+        [ROUND_EVENT_SWITCH] = ROUND_TO (ROUND_SWITCH),
+        [ROUND_EVENT_OVER] = ROUND_TO (ROUND_GAME_OVER),     // a RING's last catcher
+    },
+    [ROUND_SWITCH] = {
+        [ROUND_EVENT_SHOOT] = ROUND_TO (ROUND_AIM),
+        [ROUND_EVENT_CATCH] = ROUND_TO (ROUND_HANDOFF),
+        [ROUND_EVENT_OVER] = ROUND_TO (ROUND_GAME_OVER),
+    },
+    [ROUND_GAME_OVER] = {
+        // the next match starts from a fresh state in ROUND_SELECT
+    },
+    [ROUND_WATCH] = {
+        [ROUND_EVENT_CATCH] = ROUND_TO (ROUND_HANDOFF),
+        [ROUND_EVENT_WATCH] = ROUND_TO (ROUND_WATCH),
+        [ROUND_EVENT_OVER] = ROUND_TO (ROUND_GAME_OVER),
+    },
+};
+
+static uint16_t round_illegal_events;
+
+
+round_state_t round_event (round_state_t state, round_event_t event)
+{
+    uint8_t next = pgm_read_byte (&round_table[state][event]);
+
+    if (next == ROUND_NO_MOVE) {
+        round_illegal_events++;
+        return state;
+    }
+    return next - 1;
+}
+
+
+uint16_t round_illegal (void)
+{
+    return round_illegal_events;
+}
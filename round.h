@@ -0,0 +1,65 @@
+/** @file round.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief the round's state machine. Each board is in one round state and
+ *  the game raises an event whenever something moves the round on, a ball
+ *  fired or landing, the last ball in, a score arriving. One table in flash
+ *  gives the state each event leads to from each state, so the round's
+ *  flow is all in one place. Shooter and catcher each have their own states
+ *  in play, so what a board does in a state never depends on its role, and
+ *  both come to ROUND_SCORE_SYNC when the round is over. An
+ *  event the table has no move for leaves the state alone and is counted,
+ *  a board that has lost track of the round carries on instead of hanging
+ *  the match.
+ */
+
+#ifndef ROUND_H
+#define ROUND_H
+
+#include "system.h"
+
+typedef enum round_state
+{
+    ROUND_SELECT,     // role screen, a match starts here
+    ROUND_AIM,        // shooter with a ball loaded
+    ROUND_IN_FLIGHT,  // a ball on the shooter's screen, or it has none left to load
+    ROUND_HANDOFF,    // catcher waiting for the next ball to come across
+    ROUND_CATCHING,   // a ball on the catcher's screen
+    ROUND_SCORE_SYNC, // round over, the catcher has had every ball or the shooter its score
+    ROUND_SWITCH,     // continue screen, the players swap roles
+    ROUND_GAME_OVER,  // every round played, on to the end screen
+    ROUND_WATCH,      // another pair in a RING is playing
+    ROUND_NUM_STATES
+} round_state_t;
+
+typedef enum round_event
+{
+    ROUND_EVENT_SHOOT,   // this board shoots
+    ROUND_EVENT_CATCH,   // this board catches
+    ROUND_EVENT_WATCH,   // this board watches
+    ROUND_EVENT_FIRE,    // the shooter threw its loaded ball
+    ROUND_EVENT_LOADED,  // the shooter has a ball to load again
+    ROUND_EVENT_ARRIVED, // a ball came onto the catcher's screen
+    ROUND_EVENT_GONE,    // the catcher's screen is empty again
+    ROUND_EVENT_ALL_IN,  // the catcher has had every ball of the round
+    ROUND_EVENT_SCORE,   // the shooter has the catcher's score
+    ROUND_EVENT_SWITCH,  // the round is over
+    ROUND_EVENT_OVER,    // the match is over
+    ROUND_NUM_EVENTS
+} round_event_t;
+
+/*
+ * Look up where an event leads.
+ * @param state - current state
+ * @param event - what happened
+ * returns the next state, state itself for an event it has no move for,
+ * which is counted
+ */
+round_state_t round_event (round_state_t state, round_event_t event);
+
+/*
+ * Events that had no move from the state they came in, since power on.
+ */
+uint16_t round_illegal (void);
+
+#endif
@@ -0,0 +1,159 @@
+/** @file scan.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief interrupt driven, bit angle modulated ledmat scan with a double
+ *  buffered frame
+ */
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "system.h"
+#include "timer.h"
+#include "display.h"
+#include "ledmat.h"
+#include "profile.h"
+#include "scan.h"
+
+/* per bit plane one byte per column with bit n for row n, the interrupt
+   drives the front frame and everything else draws into the other */
+static uint8_t scan_frames[2][SCAN_PLANES][DISPLAY_WIDTH];
+static volatile uint8_t scan_front;
+static uint8_t scan_col; // only the interrupt touches these two
+static uint8_t scan_plane;
+
+
+/*
+ * Timer 1 has reached the next plane's turn, drive it and hold it for its
+ * weight.
+ */
+ISR (TIMER1_COMPB_vect)
+{
+    timer_tick_t due = OCR1B;
+
+    OCR1B = due + (SCAN_SLOT << scan_plane);
+    ledmat_display_column (scan_frames[scan_front][scan_plane][scan_col], scan_col);
+    if (!scan_plane) {
+        PROFILE_LATENCY_SHOWN (scan_col);
+    }
+    scan_plane++;
+    if (scan_plane == SCAN_PLANES) {
+        scan_plane = 0;
+        scan_col++;
+        if (scan_col == DISPLAY_WIDTH) {
+            scan_col = 0;
+        }
+    }
+    PROFILE_SCAN (due);
+}
+
+
+/*
+ * Start the scan, the timer must already be running so call after sched_init.
+ */
+void display_init (void)
+{
+    uint8_t plane, col;
+
+    ledmat_init ();
+    for (plane = 0; plane < SCAN_PLANES; plane++) {
+        for (col = 0; col < DISPLAY_WIDTH; col++) {
+            scan_frames[0][plane][col] = 0;
+            scan_frames[1][plane][col] = 0;
+        }
+    }
+    scan_front = 0;
+    scan_col = 0;
+    scan_plane = 0;
+    cli ();
+    OCR1B = timer_get () + SCAN_SLOT;
+    TIFR1 = _BV (OCF1B);
+    TIMSK1 |= _BV (OCIE1B);
+    sei ();
+}
+
+
+/*
+ * Hand the back frame to the interrupt if anything was drawn into it, then
+ * carry on drawing from a copy of it.
+ */
+void display_update (void)
+{
+    uint8_t (*back)[DISPLAY_WIDTH] = scan_frames[scan_front ^ 1];
+    uint8_t (*front)[DISPLAY_WIDTH] = scan_frames[scan_front];
+    bool changed = 0;
+    uint8_t plane, col;
+
+    for (col = 0; col < DISPLAY_WIDTH; col++) {
+        for (plane = 0; plane < SCAN_PLANES; plane++) {
+            if (back[plane][col] != front[plane][col]) {
+                PROFILE_LATENCY_PUSHED (col);
+                changed = 1;
+                break;
+            }
+        }
+    }
+    if (!changed) {
+        return;
+    }
+    scan_front ^= 1; // a single byte, the interrupt takes one frame or the other
+    for (plane = 0; plane < SCAN_PLANES; plane++) {
+        for (col = 0; col < DISPLAY_WIDTH; col++) {
+            front[plane][col] = back[plane][col];
+        }
+    }
+}
+
+
+void display_clear (void)
+{
+    uint8_t (*back)[DISPLAY_WIDTH] = scan_frames[scan_front ^ 1];
+    uint8_t plane, col;
+
+    for (plane = 0; plane < SCAN_PLANES; plane++) {
+        for (col = 0; col < DISPLAY_WIDTH; col++) {
+            back[plane][col] = 0;
+        }
+    }
+}
+
+
+void scan_pixel_level (uint8_t col, uint8_t row, uint8_t level)
+{
+    uint8_t (*back)[DISPLAY_WIDTH] = scan_frames[scan_front ^ 1];
+    uint8_t plane;
+
+    if (col >= DISPLAY_WIDTH || row >= DISPLAY_HEIGHT) {
+        return;
+    }
+    for (plane = 0; plane < SCAN_PLANES; plane++) {
+        if ((level >> plane) & 1) {
+            back[plane][col] |= 1 << row;
+        } else {
+            back[plane][col] &= ~(1 << row);
+        }
+    }
+}
+
+
+void display_pixel_set (uint8_t col, uint8_t row, bool val)
+{
+    scan_pixel_level (col, row, val ? SCAN_LEVEL_FULL : 0);
+}
+
+
+/*
+ * A pixel lit at any level reads as on.
+ */
+bool display_pixel_get (uint8_t col, uint8_t row)
+{
+    uint8_t (*back)[DISPLAY_WIDTH] = scan_frames[scan_front ^ 1];
+    uint8_t plane, lit = 0;
+
+    if (col >= DISPLAY_WIDTH || row >= DISPLAY_HEIGHT) {
+        return 0;
+    }
+    for (plane = 0; plane < SCAN_PLANES; plane++) {
+        lit |= back[plane][col];
+    }
+    return (lit >> row) & 1;
+}
@@ -0,0 +1,59 @@
+/** @file scan.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief interrupt driven ledmat scan, takes the place of the UCFK4 display
+ *  driver behind the same display.h calls. Timer 1's second compare drives
+ *  one column onto the LEDs per interrupt from the front of two frames,
+ *  while tinygl and frame_flush draw into the back one. display_update
+ *  hands the back frame over whole, so the LEDs never show half a tick's
+ *  drawing and keep refreshing at the same rate however slowly or unevenly
+ *  the game loop runs.
+ *
+ *  Each pixel has a brightness of 0 to SCAN_LEVEL_FULL, kept as one bit
+ *  plane per bit of the level. Bit angle modulation drives each column once
+ *  per plane with plane n held on the LEDs for SCAN_SLOT << n counts, so a
+ *  pixel is lit for its level's share of the column's time. Every
+ *  interrupt does the same work whatever is drawn, with no loop over rows
+ *  or levels, and PROFILE builds time each one against SCAN_BUDGET.
+ */
+
+#ifndef SCAN_H
+#define SCAN_H
+
+#include "system.h"
+#include "timer.h"
+#include "display.h"
+
+/* Columns driven per second, 5 to a frame so the LEDs refresh at 100 Hz. */
+#define SCAN_COLUMN_RATE 500
+
+/* Bit planes of brightness, a pixel at SCAN_LEVEL_FULL is lit the whole time
+   its column is driven and tinygl's pixels are all full or off. */
+#define SCAN_PLANES 2
+#define SCAN_LEVEL_FULL ((1 << SCAN_PLANES) - 1)
+
+/* Timer counts the lowest plane is shown for, the column's time split in
+   SCAN_LEVEL_FULL slots. */
+#define SCAN_SLOT ((timer_tick_t) (TIMER_RATE / ((uint32_t) SCAN_COLUMN_RATE * SCAN_LEVEL_FULL)))
+
+/* Timer counts between columns. */
+#define SCAN_PERIOD (SCAN_SLOT * SCAN_LEVEL_FULL)
+
+/* Timer counts for the scan to go right across the LEDs. */
+#define SCAN_FRAME_TIME (SCAN_PERIOD * DISPLAY_WIDTH)
+
+/* Timer counts one interrupt may take from its compare match to returning,
+   SCAN_PLANES of them a column. Two counts is 512 cycles, a frame's worth
+   of interrupts under 7% of the CPU. */
+#define SCAN_BUDGET 2
+
+/*
+ * Set the brightness of one pixel of the frame being drawn, points off the
+ * screen are ignored. display_pixel_set sets pixels full or off.
+ * @param col - column
+ * @param row - row
+ * @param level - 0 for off to SCAN_LEVEL_FULL
+ */
+void scan_pixel_level (uint8_t col, uint8_t row, uint8_t level);
+
+#endif
@@ -0,0 +1,125 @@
+/** @file sched.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief cooperative task scheduler with idle sleep
+ */
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include "system.h"
+#include "timer.h"
+#include "profile.h"
+#include "record.h"
+#include "sched.h"
+
+/* set when a sched_run returns, the task that called it has been away for
+   longer than the timer can compare across */
+static bool sched_resync;
+
+
+/*
+ * Timer 1 has reached the next task's due time. There is nothing to do here,
+ * taking the interrupt is what ends the sleep.
+ */
+ISR (TIMER1_COMPA_vect)
+{
+}
+
+
+void sched_init (void)
+{
+    timer_init ();
+    set_sleep_mode (SLEEP_MODE_IDLE);
+    TIMSK1 |= _BV (OCIE1A);
+    sei ();
+}
+
+
+/*
+ * Checks if a time has been reached, the timer wraps so compare the difference.
+ */
+static bool sched_reached_p (timer_tick_t now, timer_tick_t time)
+{
+    return (int16_t) (now - time) >= 0;
+}
+
+
+/*
+ * Sleep until the timer reaches wake, or until any other interrupt.
+ * @param wake - timer count to wake at
+ */
+static void sched_sleep_until (timer_tick_t wake)
+{
+    cli ();
+    OCR1A = wake;
+    TIFR1 = _BV (OCF1A);
+    if (!sched_reached_p (timer_get (), wake)) {
+        sleep_enable ();
+        sei (); // sei only takes effect after the next instruction, so a compare landing now still wakes sleep_cpu
+        sleep_cpu ();
+        sleep_disable ();
+    }
+    sei ();
+}
+
+
+void sched_run (sched_task_t* tasks, uint8_t num_tasks, const bool* done)
+{
+    timer_tick_t now = timer_get ();
+    timer_tick_t wait;
+    timer_tick_t next_wait;
+    bool ran;
+    uint8_t i;
+    uint8_t j;
+
+    for (i = 0; i < num_tasks; i++) {
+        tasks[i].due = now;
+    }
+    sched_resync = 0;
+    while (!done || !*done) {
+        now = timer_get ();
+        wait = ~0;
+        ran = 0;
+        for (i = 0; i < num_tasks; i++) {
+            sched_task_t* task = &tasks[i];
+
+            if (sched_reached_p (now, task->due)) {
+                if (!ran) {
+                    PROFILE_TICK_START ();
+                    RECORD_TICK ();
+                    ran = 1;
+                }
+                task->func (task->data);
+                if (sched_resync) { // the task ran a screen of its own, start afresh
+                    sched_resync = 0;
+                    now = timer_get ();
+                    for (j = 0; j < num_tasks; j++) {
+                        tasks[j].due = now;
+                    }
+                    wait = 0;
+                }
+                task->due += task->period;
+                if (sched_reached_p (now, task->due)) { // a whole period behind, skip ahead
+                    task->due = now + task->period;
+                }
+            }
+        }
+        for (i = 0; i < num_tasks; i++) { // after all have run, a task may have moved another
+            next_wait = tasks[i].due - now;
+            if (next_wait < wait) {
+                wait = next_wait;
+            }
+        }
+        if (!done || !*done) {
+            sched_sleep_until (now + wait);
+        }
+    }
+    sched_resync = 1;
+}
+
+
+void sched_restart (sched_task_t* task, timer_tick_t time)
+{
+    task->due = time;
+}
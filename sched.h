@@ -0,0 +1,56 @@
+/** @file sched.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief cooperative task scheduler. Each task runs at its own rate off
+ *  timer 1 and between tasks the MCU sleeps in idle mode until the timer's
+ *  compare interrupt wakes it for the next one that is due.
+ */
+
+#ifndef SCHED_H
+#define SCHED_H
+
+#include "system.h"
+#include "timer.h"
+
+/* Timer counts between runs of a task at rate Hz. */
+#define SCHED_PERIOD(rate) (TIMER_RATE / (rate))
+
+/* Initialiser for a task table entry. */
+#define SCHED_TASK(f, d, rate) {.func = (f), .data = (d), .period = SCHED_PERIOD (rate)}
+
+typedef void (*sched_func_t) (void* data);
+
+typedef struct sched_task
+{
+    sched_func_t func;      // called once per period
+    void* data;             // handed to func
+    timer_tick_t period;    // timer counts, at most half the timer's range
+    timer_tick_t due;       // next time to run, kept by the scheduler
+} sched_task_t;
+
+/*
+ * Start timer 1 and its compare interrupt, call once at power on.
+ */
+void sched_init (void);
+
+/*
+ * Run a table of tasks, sleeping whenever none is due. All tasks run
+ * straight away, then each once per period. A task that falls a whole period
+ * behind skips the missed runs rather than running back to back. Tasks may
+ * call sched_run again for a screen of their own, the outer tasks pick up
+ * where they were once it returns.
+ * @param tasks - task table
+ * @param num_tasks - number of tasks in the table
+ * @param done - checked after each wake, returns once a task sets it, NULL to run forever
+ */
+void sched_run (sched_task_t* tasks, uint8_t num_tasks, const bool* done);
+
+/*
+ * Make a task's next run fall at a given time, to line it up with a clock kept
+ * elsewhere. Call it from a different task.
+ * @param task - task to restart
+ * @param time - timer count to run at, at most a period from now
+ */
+void sched_restart (sched_task_t* task, timer_tick_t time);
+
+#endif
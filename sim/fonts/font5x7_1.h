@@ -0,0 +1,15 @@
+/** @file font5x7_1.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in for the UCFK4 5x7 font, the simulator reports text
+ *  rather than rendering glyphs so only the size is kept
+ */
+
+#ifndef FONT5X7_1_H
+#define FONT5X7_1_H
+
+#include "font.h"
+
+static font_t font5x7_1 __attribute__ ((unused)) = {5, 7};
+
+#endif
@@ -0,0 +1,57 @@
+/** @file avr.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in registers and interrupt vectors
+ */
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+volatile uint8_t UCSR1B;
+volatile uint8_t UDR1;
+volatile uint16_t OCR1A;
+volatile uint16_t OCR1B;
+volatile uint8_t TIMSK1;
+volatile uint8_t TIFR1;
+volatile uint8_t PCICR;
+volatile uint8_t PCMSK1;
+volatile uint8_t EECR;
+
+volatile bool avr_interrupts_enabled;
+
+
+void sei (void)
+{
+    avr_interrupts_enabled = 1;
+}
+
+
+void cli (void)
+{
+    avr_interrupts_enabled = 0;
+}
+
+
+__attribute__ ((weak)) ISR (USART1_RX_vect)
+{
+}
+
+
+__attribute__ ((weak)) ISR (TIMER1_COMPA_vect)
+{
+}
+
+
+__attribute__ ((weak)) ISR (TIMER1_COMPB_vect)
+{
+}
+
+
+__attribute__ ((weak)) ISR (PCINT1_vect)
+{
+}
+
+
+__attribute__ ((weak)) ISR (EE_READY_vect)
+{
+}
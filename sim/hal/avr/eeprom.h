@@ -0,0 +1,31 @@
+/** @file eeprom.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in for avr/eeprom.h. A write that changes a byte keeps
+ *  the EEPROM busy for as long as the funkit's does, and one started while
+ *  it is busy waits for it as avr-libc's does.
+ */
+
+#ifndef AVR_EEPROM_H
+#define AVR_EEPROM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../../sim.h"
+
+/* Erase and write of one byte on the ATmega32U2. */
+#define EEPROM_WRITE_US 3400
+
+bool eeprom_is_ready (void);
+
+uint8_t eeprom_read_byte (const uint8_t* address);
+
+void eeprom_update_byte (uint8_t* address, uint8_t value);
+
+/*
+ * Host only, when the EEPROM is next free, for sleep_cpu to raise
+ * EE_READY_vect at.
+ */
+sim_time_t eeprom_ready_time (void);
+
+#endif
@@ -0,0 +1,30 @@
+/** @file interrupt.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in for avr/interrupt.h. An ISR is a plain function the
+ *  stand-in drivers call while the board is suspended, which on a funkit is
+ *  an interrupt landing while it sleeps. Vectors nobody defines fall back
+ *  to empty weak ones.
+ */
+
+#ifndef AVR_INTERRUPT_H
+#define AVR_INTERRUPT_H
+
+#include <stdbool.h>
+
+#define ISR(vector) void vector (void)
+
+void USART1_RX_vect (void);
+void TIMER1_COMPA_vect (void);
+void TIMER1_COMPB_vect (void);
+void PCINT1_vect (void);
+void EE_READY_vect (void);
+
+/* Global interrupt enable, the I bit of SREG. */
+extern volatile bool avr_interrupts_enabled;
+
+void sei (void);
+
+void cli (void);
+
+#endif
@@ -0,0 +1,44 @@
+/** @file io.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in for avr/io.h, only the registers the game touches
+ *  directly. The stand-in drivers read them to decide when to raise an
+ *  interrupt.
+ */
+
+#ifndef AVR_IO_H
+#define AVR_IO_H
+
+#include <stdint.h>
+
+#define _BV(bit) (1 << (bit))
+
+/* USART1 */
+extern volatile uint8_t UCSR1B;
+extern volatile uint8_t UDR1;
+#define RXCIE1 7
+
+/* Timer 1, the count itself is timer_get () */
+extern volatile uint16_t OCR1A;
+extern volatile uint16_t OCR1B;
+extern volatile uint8_t TIMSK1;
+extern volatile uint8_t TIFR1;
+#define OCIE1A 1
+#define OCIE1B 2
+#define OCF1A 1
+#define OCF1B 2
+
+/* Pin change interrupts, PCMSK1 picks the port C pins */
+extern volatile uint8_t PCICR;
+extern volatile uint8_t PCMSK1;
+#define PCIE1 1
+
+/* EEPROM control, EERIE raises EE_READY_vect while the EEPROM is free */
+extern volatile uint8_t EECR;
+#define EERIE 3
+
+/* Last EEPROM address, the funkit's 1 KB, so a host log stops where the
+   funkit's would. */
+#define E2END 0x3FF
+
+#endif
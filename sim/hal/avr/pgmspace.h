@@ -0,0 +1,22 @@
+/** @file pgmspace.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in for avr/pgmspace.h, the host has one address space
+ *  so flash data is ordinary const data
+ */
+
+#ifndef AVR_PGMSPACE_H
+#define AVR_PGMSPACE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PSTR(s) (s)
+
+#define pgm_read_byte(address) (*(const uint8_t*) (address))
+#define pgm_read_ptr(address) (*(void* const*) (address))
+
+#define strncpy_P(dest, src, n) strncpy ((dest), (src), (n))
+
+#endif
@@ -0,0 +1,22 @@
+/** @file sleep.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in for avr/sleep.h. Sleeping hands the virtual clock
+ *  back to the world until timer 1 reaches OCR1A, then takes the compare
+ *  interrupt. IR bytes landing meanwhile run their interrupt but, unlike the
+ *  chip, do not end the sleep early, a scheduler would go straight back to
+ *  sleep anyway.
+ */
+
+#ifndef AVR_SLEEP_H
+#define AVR_SLEEP_H
+
+#define SLEEP_MODE_IDLE 0
+
+#define set_sleep_mode(mode) ((void) (mode))
+#define sleep_enable() ((void) 0)
+#define sleep_disable() ((void) 0)
+
+void sleep_cpu (void);
+
+#endif
@@ -0,0 +1,37 @@
+/** @file board.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief entry points the world uses to power on and inspect a board
+ */
+
+#include "board.h"
+
+int main (void);
+
+const sim_world_t* board_world;
+uint8_t board_id;
+
+
+void sim_board_attach (const sim_world_t* world, uint8_t id)
+{
+    board_world = world;
+    board_id = id;
+}
+
+
+void sim_board_run (void)
+{
+    main ();
+}
+
+
+void board_wait_until (sim_time_t wake)
+{
+    board_world->wait_until (board_id, wake);
+}
+
+
+sim_time_t board_now (void)
+{
+    return board_world->now ();
+}
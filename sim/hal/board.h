@@ -0,0 +1,27 @@
+/** @file board.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief state shared by the host stand-in drivers of one simulated board
+ */
+
+#ifndef BOARD_H
+#define BOARD_H
+
+#include "../sim.h"
+
+/* The world this board is plugged into and its index there. */
+extern const sim_world_t* board_world;
+extern uint8_t board_id;
+
+/*
+ * Give the virtual clock back to the world until wake.
+ * @param wake - virtual time to resume at
+ */
+void board_wait_until (sim_time_t wake);
+
+/*
+ * Current virtual time.
+ */
+sim_time_t board_now (void);
+
+#endif
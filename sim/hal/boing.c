@@ -0,0 +1,63 @@
+/** @file boing.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in for the UCFK4 bouncing ball module
+ */
+
+#include "boing.h"
+
+/* Step for each direction, indexed by boing_dir_t. */
+static const int8_t boing_dx[] = {0, 1, 1, 1, 0, -1, -1, -1};
+static const int8_t boing_dy[] = {-1, -1, 0, 1, 1, 1, 0, -1};
+
+
+/*
+ * Direction with the given step.
+ */
+static boing_dir_t boing_dir (int8_t dx, int8_t dy)
+{
+    uint8_t dir;
+
+    for (dir = DIR_N; dir <= DIR_NW; dir++) {
+        if (boing_dx[dir] == dx && boing_dy[dir] == dy) {
+            break;
+        }
+    }
+    return dir;
+}
+
+
+boing_state_t boing_init (uint8_t xstart, uint8_t ystart, boing_dir_t dir)
+{
+    boing_state_t state;
+
+    state.pos.x = xstart;
+    state.pos.y = ystart;
+    state.dir = dir;
+    return state;
+}
+
+
+boing_state_t boing_update (boing_state_t state)
+{
+    int8_t dx = boing_dx[state.dir];
+    int8_t dy = boing_dy[state.dir];
+
+    if (state.pos.x + dx < 0 || state.pos.x + dx >= TINYGL_WIDTH) {
+        dx = -dx;
+    }
+    if (state.pos.y + dy < 0 || state.pos.y + dy >= TINYGL_HEIGHT) {
+        dy = -dy;
+    }
+    state.pos.x += dx;
+    state.pos.y += dy;
+    state.dir = boing_dir (dx, dy);
+    return state;
+}
+
+
+boing_state_t boing_reverse (boing_state_t state)
+{
+    state.dir = boing_dir (-boing_dx[state.dir], -boing_dy[state.dir]);
+    return state;
+}
@@ -0,0 +1,30 @@
+/** @file boing.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in for the UCFK4 bouncing ball module
+ */
+
+#ifndef BOING_H
+#define BOING_H
+
+#include "system.h"
+#include "tinygl.h"
+
+typedef enum dir {DIR_N, DIR_NE, DIR_E, DIR_SE, DIR_S, DIR_SW, DIR_W, DIR_NW} boing_dir_t;
+
+typedef struct boing_state_struct
+{
+    tinygl_point_t pos;
+    boing_dir_t dir;
+} boing_state_t;
+
+boing_state_t boing_init (uint8_t xstart, uint8_t ystart, boing_dir_t dir);
+
+/*
+ * Move one step in the current direction, bouncing off the display edges.
+ */
+boing_state_t boing_update (boing_state_t state);
+
+boing_state_t boing_reverse (boing_state_t state);
+
+#endif
@@ -0,0 +1,26 @@
+/** @file display.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in for the UCFK4 display driver header, scan.c provides
+ *  the functions on both the funkit and the host
+ */
+
+#ifndef DISPLAY_H
+#define DISPLAY_H
+
+#include "system.h"
+
+#define DISPLAY_WIDTH 5
+#define DISPLAY_HEIGHT 7
+
+void display_init (void);
+
+void display_update (void);
+
+void display_clear (void);
+
+void display_pixel_set (uint8_t col, uint8_t row, bool val);
+
+bool display_pixel_get (uint8_t col, uint8_t row);
+
+#endif
@@ -0,0 +1,50 @@
+/** @file eeprom.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in EEPROM, which the world can read back out
+ */
+
+#include <avr/io.h>
+#include <avr/eeprom.h>
+#include "../sim.h"
+#include "board.h"
+
+static uint8_t eeprom[E2END + 1];
+static sim_time_t eeprom_busy_until;
+
+
+bool eeprom_is_ready (void)
+{
+    return board_now () >= eeprom_busy_until;
+}
+
+
+sim_time_t eeprom_ready_time (void)
+{
+    return eeprom_busy_until;
+}
+
+
+uint8_t eeprom_read_byte (const uint8_t* address)
+{
+    return eeprom[(uintptr_t) address & E2END];
+}
+
+
+void eeprom_update_byte (uint8_t* address, uint8_t value)
+{
+    if (!eeprom_is_ready ()) {
+        board_wait_until (eeprom_busy_until);
+    }
+    if (eeprom[(uintptr_t) address & E2END] != value) {
+        eeprom[(uintptr_t) address & E2END] = value;
+        eeprom_busy_until = board_now () + EEPROM_WRITE_US;
+    }
+}
+
+
+const uint8_t* sim_board_eeprom (uint32_t* size)
+{
+    *size = sizeof (eeprom);
+    return eeprom;
+}
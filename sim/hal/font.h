@@ -0,0 +1,18 @@
+/** @file font.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in for the UCFK4 font type
+ */
+
+#ifndef FONT_H
+#define FONT_H
+
+#include "system.h"
+
+typedef struct font_struct
+{
+    uint8_t width;
+    uint8_t height;
+} font_t;
+
+#endif
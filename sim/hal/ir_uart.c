@@ -0,0 +1,99 @@
+/** @file ir_uart.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in for the UCFK4 IR UART driver. Received bytes land in
+ *  a two byte FIFO like the USART's, anything arriving while it is full is
+ *  lost. With the receive interrupt enabled each byte goes straight to the
+ *  USART1_RX_vect handler through UDR1 instead.
+ *
+ *  Sending blocks the way the driver's busy wait does. The USART holds one
+ *  byte going out and one behind it, so a putc with both taken waits on the
+ *  virtual clock until the one going out has finished.
+ */
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "ir_uart.h"
+#include "board.h"
+
+#define IR_UART_FIFO_SIZE 2
+
+/* Poll interval for a blocking read, well under one byte time. */
+#define IR_UART_POLL_US 500
+
+static uint8_t ir_uart_fifo[IR_UART_FIFO_SIZE];
+static uint8_t ir_uart_fifo_count;
+
+/* Bytes go out back to back, the last one queued is sent by then. */
+static sim_time_t ir_uart_tx_done;
+
+
+int8_t ir_uart_init (void)
+{
+    ir_uart_fifo_count = 0;
+    return 1;
+}
+
+
+void ir_uart_putc (char ch)
+{
+    sim_time_t start;
+
+    if (ir_uart_tx_done > board_now () + SIM_IR_BYTE_US) {
+        board_wait_until (ir_uart_tx_done - SIM_IR_BYTE_US); // until the byte going out has gone
+    }
+    start = board_now () > ir_uart_tx_done ? board_now () : ir_uart_tx_done;
+    ir_uart_tx_done = start + SIM_IR_BYTE_US;
+    board_world->ir_putc (board_id, ch);
+}
+
+
+void ir_uart_puts (const char* str)
+{
+    while (*str) {
+        ir_uart_putc (*str++);
+    }
+}
+
+
+char ir_uart_getc (void)
+{
+    char ch;
+
+    while (!ir_uart_read_ready_p ()) {
+        board_wait_until (board_now () + IR_UART_POLL_US);
+    }
+    ch = ir_uart_fifo[0];
+    ir_uart_fifo[0] = ir_uart_fifo[1];
+    ir_uart_fifo_count--;
+    return ch;
+}
+
+
+bool ir_uart_read_ready_p (void)
+{
+    return ir_uart_fifo_count != 0;
+}
+
+
+bool ir_uart_write_ready_p (void)
+{
+    return ir_uart_tx_done <= board_now () + SIM_IR_BYTE_US;
+}
+
+
+bool ir_uart_write_finished_p (void)
+{
+    return board_now () >= ir_uart_tx_done;
+}
+
+
+void sim_board_ir_arrive (uint8_t byte)
+{
+    if (avr_interrupts_enabled && (UCSR1B & _BV (RXCIE1))) {
+        UDR1 = byte;
+        USART1_RX_vect ();
+    } else if (ir_uart_fifo_count < IR_UART_FIFO_SIZE) {
+        ir_uart_fifo[ir_uart_fifo_count++] = byte;
+    }
+}
@@ -0,0 +1,32 @@
+/** @file ir_uart.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in for the UCFK4 IR UART driver, bytes travel over the
+ *  world's virtual IR link
+ */
+
+#ifndef IR_UART_H
+#define IR_UART_H
+
+#include "system.h"
+
+#define IR_UART_BAUD_RATE 2400
+
+int8_t ir_uart_init (void);
+
+void ir_uart_putc (char ch);
+
+void ir_uart_puts (const char* str);
+
+/*
+ * Read a byte, blocking like the real driver until one has arrived.
+ */
+char ir_uart_getc (void);
+
+bool ir_uart_read_ready_p (void);
+
+bool ir_uart_write_ready_p (void);
+
+bool ir_uart_write_finished_p (void);
+
+#endif
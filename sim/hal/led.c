@@ -0,0 +1,22 @@
+/** @file led.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in for the UCFK4 LED driver
+ */
+
+#include "led.h"
+
+static bool led_state;
+
+
+void led_init (void)
+{
+    led_state = 0;
+}
+
+
+void led_set (uint8_t led, bool state)
+{
+    (void) led;
+    led_state = state;
+}
@@ -0,0 +1,18 @@
+/** @file led.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in for the UCFK4 LED driver
+ */
+
+#ifndef LED_H
+#define LED_H
+
+#include "system.h"
+
+#define LED1 0
+
+void led_init (void);
+
+void led_set (uint8_t led, bool state);
+
+#endif
@@ -0,0 +1,51 @@
+/** @file ledmat.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in for the UCFK4 LED matrix driver. Keeps every row
+ *  driven onto each column the last time the scan was on it, which is what
+ *  an eye sees of a matrix scanned faster than it can follow, a row lit for
+ *  only some of its bit planes shows dimmer but still shows.
+ */
+
+#include "ledmat.h"
+#include "display.h"
+#include "../sim.h"
+
+/* One byte per column, bit n is row n. */
+static uint8_t ledmat_columns[DISPLAY_WIDTH];
+static uint8_t ledmat_column;
+
+
+void ledmat_init (void)
+{
+    uint8_t col;
+
+    for (col = 0; col < DISPLAY_WIDTH; col++) {
+        ledmat_columns[col] = 0;
+    }
+    ledmat_column = 0;
+}
+
+
+void ledmat_display_column (uint8_t pattern, uint8_t col)
+{
+    if (col >= DISPLAY_WIDTH) {
+        return;
+    }
+    if (col == ledmat_column) {
+        ledmat_columns[col] |= pattern; // the next plane of the same column
+    } else {
+        ledmat_columns[col] = pattern;
+    }
+    ledmat_column = col;
+}
+
+
+void sim_board_pixels (uint8_t* columns)
+{
+    uint8_t col;
+
+    for (col = 0; col < DISPLAY_WIDTH; col++) {
+        columns[col] = ledmat_columns[col];
+    }
+}
@@ -0,0 +1,16 @@
+/** @file ledmat.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in for the UCFK4 LED matrix driver
+ */
+
+#ifndef LEDMAT_H
+#define LEDMAT_H
+
+#include "system.h"
+
+void ledmat_init (void);
+
+void ledmat_display_column (uint8_t pattern, uint8_t col);
+
+#endif
@@ -0,0 +1,66 @@
+/** @file navswitch.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in for the UCFK4 navswitch driver and the navswitch
+ *  pins. A change of buttons raises the pin change interrupt when it is
+ *  enabled, except for east whose pin has no pin change interrupt.
+ */
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "navswitch.h"
+#include "pio.h"
+#include "../sim.h"
+
+/* Buttons held as set by the world and as last sampled by the game. */
+static uint8_t navswitch_held;
+static uint8_t navswitch_state;
+static uint8_t navswitch_prev_state;
+
+
+void navswitch_init (void)
+{
+    navswitch_state = navswitch_prev_state = 0;
+}
+
+
+void navswitch_update (void)
+{
+    navswitch_prev_state = navswitch_state;
+    navswitch_state = navswitch_held;
+}
+
+
+bool navswitch_down_p (uint8_t navswitch)
+{
+    return (navswitch_state >> navswitch) & 1;
+}
+
+
+bool navswitch_push_event_p (uint8_t navswitch)
+{
+    return ((navswitch_state & ~navswitch_prev_state) >> navswitch) & 1;
+}
+
+
+bool navswitch_release_event_p (uint8_t navswitch)
+{
+    return ((~navswitch_state & navswitch_prev_state) >> navswitch) & 1;
+}
+
+
+bool pio_input_get (pio_t pio)
+{
+    return !((navswitch_held >> pio) & 1);
+}
+
+
+void sim_board_navswitch_set (uint8_t down_mask)
+{
+    uint8_t changed = navswitch_held ^ down_mask;
+
+    navswitch_held = down_mask;
+    if ((changed & ~_BV (NAVSWITCH_EAST)) && avr_interrupts_enabled && (PCICR & _BV (PCIE1)) && PCMSK1) {
+        PCINT1_vect ();
+    }
+}
@@ -0,0 +1,30 @@
+/** @file navswitch.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in for the UCFK4 navswitch driver, button state is set
+ *  by the world from a script or a random player
+ */
+
+#ifndef NAVSWITCH_H
+#define NAVSWITCH_H
+
+#include "system.h"
+
+enum {NAVSWITCH_NORTH, NAVSWITCH_EAST, NAVSWITCH_SOUTH, NAVSWITCH_WEST,
+      NAVSWITCH_PUSH, NAVSWITCH_NUM};
+
+void navswitch_init (void);
+
+/*
+ * Sample the buttons, push and release events are relative to the previous
+ * call.
+ */
+void navswitch_update (void);
+
+bool navswitch_down_p (uint8_t navswitch);
+
+bool navswitch_push_event_p (uint8_t navswitch);
+
+bool navswitch_release_event_p (uint8_t navswitch);
+
+#endif
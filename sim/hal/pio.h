@@ -0,0 +1,21 @@
+/** @file pio.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in for the UCFK4 PIO driver, only inputs. The only
+ *  pins the game reads directly are the navswitch's.
+ */
+
+#ifndef PIO_H
+#define PIO_H
+
+#include "system.h"
+
+typedef uint8_t pio_t;
+
+/*
+ * Level on a pin, the navswitch pins read low while held.
+ * @param pio - one of the NAVSWITCH_*_PIO pins
+ */
+bool pio_input_get (pio_t pio);
+
+#endif
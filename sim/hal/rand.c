@@ -0,0 +1,41 @@
+/** @file rand.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief avr-libc's rand() and srand() so simulated ball paths match the
+ *  ones a funkit would produce from the same seed
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#define AVR_RAND_MAX 0x7FFF
+
+static uint32_t rand_next = 1;
+
+
+/*
+ * Park-Miller minimal standard generator as used by avr-libc.
+ */
+int rand (void)
+{
+    int32_t hi, lo, x;
+
+    x = rand_next;
+    if (x == 0) {
+        x = 123459876L;
+    }
+    hi = x / 127773L;
+    lo = x % 127773L;
+    x = 16807L * lo - 2836L * hi;
+    if (x < 0) {
+        x += 0x7FFFFFFFL;
+    }
+    rand_next = x;
+    return x % ((uint32_t) AVR_RAND_MAX + 1);
+}
+
+
+void srand (unsigned int seed)
+{
+    rand_next = (uint16_t) seed;
+}
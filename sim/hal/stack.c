@@ -0,0 +1,23 @@
+/** @file stack.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in for the stack high water mark, the game runs on the
+ *  host's stack so there is no funkit RAM to measure, and no power on RAM
+ *  to tell the boards apart by, so each board's index stands in for it
+ */
+
+#include "system.h"
+#include "stack.h"
+#include "board.h"
+
+
+uint16_t stack_unused (void)
+{
+    return 0;
+}
+
+
+uint16_t stack_noise (void)
+{
+    return (board_id + 1) * 0x9E37;
+}
@@ -0,0 +1,12 @@
+/** @file system.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in for the UCFK4 system driver
+ */
+
+#include "system.h"
+
+
+void system_init (void)
+{
+}
@@ -0,0 +1,28 @@
+/** @file system.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in for the UCFK4 system driver
+ */
+
+#ifndef SYSTEM_H
+#define SYSTEM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define F_CPU 8000000
+
+/* Navswitch pins, from target.h on the funkit. On the host a pio is the
+   navswitch button number. */
+#define NAVSWITCH_NORTH_PIO 0
+#define NAVSWITCH_EAST_PIO 1
+#define NAVSWITCH_SOUTH_PIO 2
+#define NAVSWITCH_WEST_PIO 3
+#define NAVSWITCH_PUSH_PIO 4
+
+/*
+ * Initialise the board, nothing to do on the host.
+ */
+void system_init (void);
+
+#endif
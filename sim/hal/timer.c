@@ -0,0 +1,73 @@
+/** @file timer.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in for the UCFK4 timer driver and for sleep_cpu, which
+ *  waits on the timer and the EEPROM
+ */
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <avr/eeprom.h>
+#include "timer.h"
+#include "board.h"
+
+/* Timer counts since power on, without wrapping. */
+static uint64_t timer_count (void)
+{
+    return board_now () * TIMER_RATE / 1000000;
+}
+
+
+bool timer_init (void)
+{
+    return 1;
+}
+
+
+timer_tick_t timer_get (void)
+{
+    return timer_count ();
+}
+
+
+/*
+ * Counts until the timer next reaches a compare value, a full wrap when it is
+ * there already.
+ */
+static uint32_t timer_ahead (uint64_t count, timer_tick_t compare)
+{
+    uint32_t ahead = (timer_tick_t) (compare - count);
+
+    return ahead ? ahead : 0x10000;
+}
+
+
+/*
+ * The chip wakes on the count reaching OCR1A, or OCR1B first while its
+ * interrupt is on, or the EEPROM coming free before either while its
+ * interrupt is on.
+ */
+void sleep_cpu (void)
+{
+    uint64_t count = timer_count ();
+    uint32_t ahead_a = timer_ahead (count, OCR1A);
+    uint32_t ahead_b = (TIMSK1 & _BV (OCIE1B)) ? timer_ahead (count, OCR1B) : ahead_a + 1;
+    uint32_t ahead = ahead_a < ahead_b ? ahead_a : ahead_b;
+    sim_time_t wake;
+
+    count += ahead;
+    wake = (count * 1000000 + TIMER_RATE - 1) / TIMER_RATE;
+    if ((EECR & _BV (EERIE)) && eeprom_ready_time () < wake) {
+        board_wait_until (eeprom_ready_time ());
+        EE_READY_vect ();
+        return;
+    }
+    board_wait_until (wake);
+    if (ahead_b == ahead) {
+        TIMER1_COMPB_vect ();
+    }
+    if (ahead_a == ahead && (TIMSK1 & _BV (OCIE1A))) {
+        TIMER1_COMPA_vect ();
+    }
+}
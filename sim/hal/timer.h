@@ -0,0 +1,24 @@
+/** @file timer.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in for the UCFK4 timer driver. Timer 1 counts the
+ *  virtual clock at the same prescaled rate as on the funkit. The virtual
+ *  clock stands still while board code runs, so profiled phases read as
+ *  zero cycles on the host, only the counts of runs are meaningful.
+ */
+
+#ifndef TIMER_H
+#define TIMER_H
+
+#include "system.h"
+
+typedef uint16_t timer_tick_t;
+
+#define TIMER_CLOCK_DIVISOR 256
+#define TIMER_RATE (F_CPU / TIMER_CLOCK_DIVISOR)
+
+bool timer_init (void);
+
+timer_tick_t timer_get (void);
+
+#endif
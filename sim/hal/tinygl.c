@@ -0,0 +1,86 @@
+/** @file tinygl.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in for the UCFK4 tiny graphics library. Text is kept as
+ *  a string for the world to read instead of being scrolled across the
+ *  display.
+ */
+
+#include <string.h>
+#include "tinygl.h"
+#include "../sim.h"
+
+#define TINYGL_MESSAGE_SIZE 192
+
+static char tinygl_message[TINYGL_MESSAGE_SIZE];
+
+
+void tinygl_init (uint16_t update_rate)
+{
+    (void) update_rate;
+    display_init ();
+    tinygl_clear ();
+}
+
+
+void tinygl_update (void)
+{
+    display_update ();
+}
+
+
+void tinygl_clear (void)
+{
+    tinygl_message[0] = '\0';
+    display_clear ();
+}
+
+
+void tinygl_draw_point (tinygl_point_t point, tinygl_pixel_value_t value)
+{
+    display_pixel_set (point.x, point.y, value);
+}
+
+
+tinygl_pixel_value_t tinygl_pixel_get (tinygl_point_t point)
+{
+    return display_pixel_get (point.x, point.y);
+}
+
+
+void tinygl_font_set (font_t* font)
+{
+    (void) font;
+}
+
+
+void tinygl_text_speed_set (uint8_t speed)
+{
+    (void) speed;
+}
+
+
+void tinygl_text_mode_set (tinygl_text_mode_t mode)
+{
+    (void) mode;
+}
+
+
+void tinygl_text_dir_set (tinygl_text_dir_t dir)
+{
+    (void) dir;
+}
+
+
+void tinygl_text (const char* string)
+{
+    display_clear ();
+    strncpy (tinygl_message, string, TINYGL_MESSAGE_SIZE - 1);
+    tinygl_message[TINYGL_MESSAGE_SIZE - 1] = '\0';
+}
+
+
+const char* sim_board_text (void)
+{
+    return tinygl_message;
+}
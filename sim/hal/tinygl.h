@@ -0,0 +1,65 @@
+/** @file tinygl.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief host stand-in for the UCFK4 tiny graphics library
+ */
+
+#ifndef TINYGL_H
+#define TINYGL_H
+
+#include "system.h"
+#include "display.h"
+#include "font.h"
+
+#define TINYGL_WIDTH DISPLAY_WIDTH
+#define TINYGL_HEIGHT DISPLAY_HEIGHT
+
+typedef int8_t tinygl_coord_t;
+
+typedef uint8_t tinygl_pixel_value_t;
+
+typedef struct tinygl_point
+{
+    tinygl_coord_t x;
+    tinygl_coord_t y;
+} tinygl_point_t;
+
+typedef enum
+{
+    TINYGL_TEXT_MODE_STEP,
+    TINYGL_TEXT_MODE_SCROLL
+} tinygl_text_mode_t;
+
+typedef enum
+{
+    TINYGL_TEXT_DIR_NORMAL,
+    TINYGL_TEXT_DIR_ROTATE
+} tinygl_text_dir_t;
+
+static inline tinygl_point_t tinygl_point (tinygl_coord_t x, tinygl_coord_t y)
+{
+    tinygl_point_t point = {x, y};
+    return point;
+}
+
+void tinygl_init (uint16_t update_rate);
+
+void tinygl_update (void);
+
+void tinygl_clear (void);
+
+void tinygl_draw_point (tinygl_point_t point, tinygl_pixel_value_t value);
+
+tinygl_pixel_value_t tinygl_pixel_get (tinygl_point_t point);
+
+void tinygl_font_set (font_t* font);
+
+void tinygl_text_speed_set (uint8_t speed);
+
+void tinygl_text_mode_set (tinygl_text_mode_t mode);
+
+void tinygl_text_dir_set (tinygl_text_dir_t dir);
+
+void tinygl_text (const char* string);
+
+#endif
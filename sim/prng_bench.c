@@ -0,0 +1,141 @@
+/** @file prng_bench.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief compares the wind gust roll ball.c used to make, avr-libc rand()
+ *  with a modulo, against prng.c with each level's threshold. Reports host
+ *  time per roll and how often each gust direction comes up, and checks
+ *  that every level's threshold is LEVEL_CHANCE of its percentage and that
+ *  the gusts come up that often. Exits 1 if any level is off.
+ *
+ *  Usage: prng_bench [draws]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "prng.h"
+#include "level.h"
+
+#define OLD_JUMP_CHANCE 15 // [%] ball.c's gust chance before there were levels
+#define DEFAULT_DRAWS 10000000UL
+#define PRNG_PERIOD 65535UL // xorshift visits every non-zero state once
+
+/* Measured gust rate may be this far from the level's percentage, LEVEL_CHANCE
+   rounds to the nearest 1/256 and the draws add a little noise on top. */
+#define TOLERANCE_PERCENT 0.3
+
+/* each level's gust chance each way, as level.c's presets give it */
+static const uint8_t level_percents[LEVEL_NUM_LEVELS] = {5, 10, 15, 20};
+
+static uint8_t threshold;
+
+static double seconds(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+
+/*
+ * The old roll, rand() is avr-libc's generator from sim/hal/rand.c.
+ */
+static unsigned oldRoll(void)
+{
+    unsigned rand_num = rand() % 100 + 1;
+
+    return rand_num < OLD_JUMP_CHANCE ? 1 : rand_num > 100 - OLD_JUMP_CHANCE ? 2 : 0;
+}
+
+
+static unsigned newRoll(void)
+{
+    unsigned rand_num = prng_next();
+
+    return rand_num < threshold ? 1 : rand_num >= 256U - threshold ? 2 : 0;
+}
+
+
+/*
+ * Roll draws times and print the time per roll and each direction's share.
+ * @param counts - filled with the straight, south and north counts
+ */
+static void report(const char* name, unsigned (*roll)(void), unsigned long draws, unsigned long* counts)
+{
+    unsigned long i;
+    double start = seconds();
+    double elapsed;
+
+    counts[0] = counts[1] = counts[2] = 0;
+    for (i = 0; i < draws; i++) {
+        counts[roll()]++;
+    }
+    elapsed = seconds() - start;
+    printf("%-26s %6.2f ns/roll  south %6.3f%%  north %6.3f%%  straight %6.3f%%\n", name,
+           elapsed * 1e9 / draws, 100.0 * counts[1] / draws, 100.0 * counts[2] / draws,
+           100.0 * counts[0] / draws);
+}
+
+
+/*
+ * Check one level's threshold and the gusts it gives.
+ * returns 1 if they are right
+ */
+static int checkLevel(uint8_t level, unsigned long draws)
+{
+    unsigned long counts[3];
+    double expected = level_percents[level];
+    double south, north;
+    char name[32];
+    int ok = 1;
+
+    level_set(level);
+    threshold = level_jump_threshold();
+    if (threshold != LEVEL_CHANCE(level_percents[level])) {
+        printf("level %u: threshold %u is not LEVEL_CHANCE(%u) = %u\n", level + 1, threshold,
+               level_percents[level], LEVEL_CHANCE(level_percents[level]));
+        ok = 0;
+    }
+
+    snprintf(name, sizeof(name), "prng_next() level %u", level + 1);
+    prng_seed(1);
+    report(name, newRoll, draws, counts);
+    south = 100.0 * counts[1] / draws;
+    north = 100.0 * counts[2] / draws;
+    if (south < expected - TOLERANCE_PERCENT || south > expected + TOLERANCE_PERCENT
+        || north < expected - TOLERANCE_PERCENT || north > expected + TOLERANCE_PERCENT) {
+        printf("level %u: gusts %.3f%% south and %.3f%% north, wanted %.1f%% +/- %.1f\n", level + 1,
+               south, north, expected, TOLERANCE_PERCENT);
+        ok = 0;
+    }
+
+    /* over one whole period every byte but zero comes up exactly 256 times
+       and zero 255 times */
+    snprintf(name, sizeof(name), "prng_next() level %u period", level + 1);
+    report(name, newRoll, PRNG_PERIOD, counts);
+    if (counts[1] != threshold * 256UL - 1 || counts[2] != threshold * 256UL) {
+        printf("level %u: %lu south and %lu north over a period, wanted %lu and %lu\n", level + 1,
+               counts[1], counts[2], threshold * 256UL - 1, threshold * 256UL);
+        ok = 0;
+    }
+    return ok;
+}
+
+
+int main(int argc, char** argv)
+{
+    unsigned long draws = argc > 1 ? strtoul(argv[1], NULL, 0) : DEFAULT_DRAWS;
+    unsigned long counts[3];
+    uint8_t level;
+    int ok = 1;
+
+    srand(1);
+    report("rand() % 100 + 1", oldRoll, draws, counts);
+    for (level = 0; level < LEVEL_NUM_LEVELS; level++) {
+        ok &= checkLevel(level, draws);
+    }
+    printf(ok ? "every level within %.1f%% of its gust chance\n" : "FAILED, tolerance %.1f%%\n",
+           TOLERANCE_PERCENT);
+    return !ok;
+}
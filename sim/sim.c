@@ -0,0 +1,1013 @@
+/** @file sim.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief the simulated world: two funkits running the game off a virtual
+ *  clock, joined by an IR link, with scripted or random players. A RING=1
+ *  board.so can be played on more boards sat in a ring.
+ *
+ *  Usage: game_sim [-v] [-s seed] [-t seconds] [-d delay_us] [-f board.so]
+ *                  [-a script] [-b script] [-l prefix] [-r log]
+ *                  [-n matches] [-p drop_%] [-c corrupt_%] [-j jitter_us]
+ *                  [-w rematches] [-k boards]
+ *
+ *  Scripts hold one press per line, "<ms> <key>" with key one of N E S W P.
+ *  A board without a script gets a random player seeded from -s.
+ *
+ *  The IR channel loses (-p) or flips a bit of (-c) each byte with the given
+ *  chance and holds each byte back by up to -j on top of -d, keeping bytes in
+ *  order. A board's putc blocks until its LED is free, as on the funkit, so
+ *  bytes are only dropped if -d and -j hold more than a second of them in
+ *  the air. -n soaks: it plays that many matches on fresh boards, seeds
+ *  counting up from -s, and reports matches per second, how many hung, had
+ *  a board go back to its start screen without showing its result or ended
+ *  with the boards disagreeing on the result, how the scores fell and the
+ *  host time the game code takes per board wake. -w has the players
+ *  push through the end screen into that many more matches on the same
+ *  boards before the world stops. -k sits that many boards in a ring, each
+ *  one's IR LED facing the next, two boards face each other.
+ *
+ *  With a RECORD=1 board.so, -l saves each board's match log (see record.h)
+ *  to <prefix>0.log and <prefix>1.log. -r plays a log's navswitch changes
+ *  and IR bytes into a lone board, at the timer counts they were logged at,
+ *  and checks the board logs the same entries again.
+ */
+
+#define _GNU_SOURCE
+#include <dlfcn.h>
+#include <getopt.h>
+#include <libgen.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include "sim.h"
+#include "timer.h"
+#include "record.h"
+#include "message.h"
+
+#define MAX_BOARDS 8
+#define BOARD_STACK_SIZE (256 * 1024)
+#define IR_QUEUE_SIZE 256 // [bytes] in flight to a board, a second's worth at the IR baud rate
+#define SCRIPT_MAX 1024
+#define PRESS_US 30000       // how long a scripted press holds the button
+#define DEFAULT_LIMIT_S 900  // virtual seconds before a match counts as hung
+#define NUM_COLUMNS 5
+#define NUM_ROWS 7
+#define LOG_MAX (64 * 1024)
+#define REPLAY_TAIL_US 1000000 // how long a replay runs on past its last entry
+#define NO_SCORE 0xFFFF
+#define SOAK_SEEDS_SHOWN 8     // seeds of bad matches listed for rerunning
+
+static const char nav_keys[] = "NESWP";
+
+typedef struct ir_byte_s
+{
+    sim_time_t arrive;
+    uint8_t byte;
+} IrByte;
+
+/*
+ * One press for a board's player, key is a navswitch button index.
+ */
+typedef struct press_s
+{
+    sim_time_t start;
+    uint8_t key;
+} Press;
+
+typedef struct board_s
+{
+    void* handle;
+    ucontext_t context;
+    void* stack;
+    sim_time_t wake;
+    sim_board_navswitch_set_t navswitch_set;
+    sim_board_ir_arrive_t ir_arrive;
+    sim_board_text_t text;
+    sim_board_pixels_t pixels;
+    sim_board_eeprom_t eeprom;
+    /* bytes in flight towards this board, in arrival order */
+    IrByte ir_queue[IR_QUEUE_SIZE];
+    uint16_t ir_head;
+    uint16_t ir_count;
+    /* when this board's IR LED is next free to start a byte */
+    sim_time_t ir_tx_free;
+    /* player input, a script or else a random player */
+    Press script[SCRIPT_MAX];
+    uint16_t script_len;
+    uint16_t script_pos;
+    Press random_press;
+    /* when the player's buttons next change, the board sees each change as it happens */
+    sim_time_t input_change;
+    char last_text[192];
+    uint32_t bytes_sent;
+    uint32_t bytes_dropped;
+    uint32_t bytes_lost;
+    uint32_t bytes_corrupted;
+    /* frame being sent, followed to pick out the board's score */
+    uint8_t tx_frame[MESSAGE_PAYLOAD_MAX + MESSAGE_OVERHEAD];
+    uint8_t tx_length;
+    uint16_t score;
+    /* start screens the board has come to, the match it is on */
+    uint32_t match;
+    bool on_start;
+    /* result the board last showed, 0 won, 1 lost, 2 tied, and its match */
+    uint8_t result;
+    uint32_t result_match;
+    /* set once the board has gone on from a match without showing its result */
+    bool skipped;
+} Board;
+
+/*
+ * One entry of a match log, time is in half timer counts as in record.h.
+ */
+typedef struct log_entry_s
+{
+    uint32_t time;
+    uint8_t kind;
+    uint8_t data;
+} LogEntry;
+
+static const char* const log_kinds[RECORD_NUM_KINDS] = {"nav", "rx", "tx", "seed"};
+
+static Board boards[MAX_BOARDS];
+static uint8_t ring_size = 2; // boards in play, each sends to the next
+static ucontext_t world_context;
+static sim_time_t world_now;
+static uint8_t world_running;
+static uint32_t world_match; // match every board has to finish before the world moves on
+static uint32_t world_seed = 1;
+static uint32_t channel_seed = 1;
+static sim_time_t ir_delay;
+static sim_time_t ir_jitter;
+static double ir_drop;      // chance of losing each byte
+static double ir_corrupt;   // chance of flipping a bit of each byte
+/* host time spent running the boards */
+static uint64_t board_wakes;
+static double board_wall;
+static bool verbose;
+static uint32_t rematches;
+/* log being played into board 0, board 1 is left out */
+static LogEntry* replay;
+static uint32_t replay_len;
+static uint32_t replay_pos;
+
+
+/*
+ * xorshift32 for the random players and the IR channel, each has its own
+ * state so a lossy channel leaves the players pressing the same buttons.
+ */
+static uint32_t worldRandom(uint32_t* state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+
+/*
+ * Seed the players and the channel, every seed gives a different match.
+ */
+static void seedWorld(uint32_t seed)
+{
+    world_seed = seed << 1 | 1; // xorshift never leaves 0
+    channel_seed = world_seed * 0x9E3779B1;
+}
+
+
+/*
+ * True with the given chance, for the channel.
+ */
+static bool channelChance(double chance)
+{
+    return chance > 0 && worldRandom(&channel_seed) < chance * 4294967296.0;
+}
+
+
+static double wallTime(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+
+static void worldWaitUntil(uint8_t board, sim_time_t wake)
+{
+    boards[board].wake = wake;
+    swapcontext(&boards[board].context, &world_context);
+}
+
+
+static sim_time_t worldNow(void)
+{
+    return world_now;
+}
+
+
+/*
+ * Follow the frames a board sends and keep the score from its last
+ * MESSAGE_SCORE or the MESSAGE_TABLE it started, as it left the board
+ * whatever the channel does to it.
+ */
+static void followFrame(Board* board, uint8_t byte)
+{
+    uint8_t* frame = board->tx_frame;
+
+    if (!board->tx_length && byte != MESSAGE_SYNC) {
+        return;
+    }
+    frame[board->tx_length++] = byte;
+    if (board->tx_length < 2) {
+        return;
+    }
+    if (MESSAGE_LENGTH (frame[1]) > MESSAGE_PAYLOAD_MAX) {
+        board->tx_length = 0;
+    } else if (board->tx_length == MESSAGE_LENGTH (frame[1]) + MESSAGE_OVERHEAD) {
+        if (MESSAGE_TYPE (frame[1]) == MESSAGE_SCORE) {
+            board->score = frame[3];
+        } else if (MESSAGE_TYPE (frame[1]) == MESSAGE_TABLE && frame[3] == 0) { // a RING catcher's own table
+            board->score = frame[5];
+        }
+        board->tx_length = 0;
+    }
+}
+
+
+/*
+ * Queue a byte on the link to the next board, bytes go out back to back
+ * at the IR baud rate and the channel may lose, garble or hold them back.
+ */
+static void worldIrPutc(uint8_t board, uint8_t byte)
+{
+    Board* from = &boards[board];
+    Board* to = &boards[(board + 1) % ring_size];
+    sim_time_t start = world_now > from->ir_tx_free ? world_now : from->ir_tx_free;
+    sim_time_t arrive;
+
+    from->ir_tx_free = start + SIM_IR_BYTE_US;
+    from->bytes_sent++;
+    followFrame(from, byte);
+    if (verbose) {
+        printf("%9.3f  board %d ir tx 0x%02x\n", world_now / 1e6, board, byte);
+    }
+    if (!to->handle) {
+        return;
+    }
+    if (channelChance(ir_drop)) {
+        from->bytes_lost++;
+        return;
+    }
+    if (channelChance(ir_corrupt)) {
+        byte ^= 1 << (worldRandom(&channel_seed) & 7);
+        from->bytes_corrupted++;
+    }
+    if (to->ir_count == IR_QUEUE_SIZE) {
+        from->bytes_dropped++;
+        return;
+    }
+    arrive = from->ir_tx_free + ir_delay;
+    if (ir_jitter) {
+        arrive += worldRandom(&channel_seed) % (ir_jitter + 1);
+    }
+    if (to->ir_count) { // bytes from one LED cannot overtake each other
+        IrByte* last = &to->ir_queue[(to->ir_head + to->ir_count - 1) % IR_QUEUE_SIZE];
+        if (arrive < last->arrive) {
+            arrive = last->arrive;
+        }
+    }
+    to->ir_queue[(to->ir_head + to->ir_count) % IR_QUEUE_SIZE] = (IrByte) {arrive, byte};
+    to->ir_count++;
+}
+
+
+static const sim_world_t world = {worldWaitUntil, worldNow, worldIrPutc};
+
+
+/*
+ * Read a navswitch script into the board, returns 0 on failure.
+ */
+static bool loadScript(Board* board, const char* path)
+{
+    FILE* file = fopen(path, "r");
+    char line[128];
+    char key;
+    unsigned long ms;
+
+    if (!file) {
+        perror(path);
+        return 0;
+    }
+    while (fgets(line, sizeof(line), file) && board->script_len < SCRIPT_MAX) {
+        if (line[0] == '#' || sscanf(line, "%lu %c", &ms, &key) != 2
+            || !strchr(nav_keys, key)) {
+            continue;
+        }
+        board->script[board->script_len].start = ms * 1000;
+        board->script[board->script_len].key = strchr(nav_keys, key) - nav_keys;
+        board->script_len++;
+    }
+    fclose(file);
+    return 1;
+}
+
+
+/*
+ * Buttons a board's player is holding right now.
+ */
+static uint8_t playerInput(Board* board)
+{
+    Press* press;
+
+    if (board->script_len) {
+        while (board->script_pos < board->script_len
+               && board->script[board->script_pos].start + PRESS_US <= world_now) {
+            board->script_pos++;
+        }
+        press = &board->script[board->script_pos];
+        if (board->script_pos == board->script_len || press->start > world_now) {
+            return 0;
+        }
+        return 1 << press->key;
+    }
+
+    /* random player: a short press every 0.1 to 0.7 seconds */
+    press = &board->random_press;
+    if (press->start + PRESS_US <= world_now) {
+        uint32_t roll = worldRandom(&world_seed) % 10;
+        press->start = world_now + 100000 + worldRandom(&world_seed) % 600000;
+        press->key = roll < 4 ? 4 : roll < 7 ? 0 : 2;
+    }
+    return press->start <= world_now ? 1 << press->key : 0;
+}
+
+
+/*
+ * Hand the board the buttons its player holds now and work out when they
+ * next change.
+ */
+static void applyInput(Board* board)
+{
+    uint8_t held = playerInput(board);
+    Press* press = board->script_len ? &board->script[board->script_pos] : &board->random_press;
+
+    board->navswitch_set(held);
+    if (board->script_len && board->script_pos == board->script_len) {
+        board->input_change = ~(sim_time_t) 0;
+    } else {
+        board->input_change = press->start > world_now ? press->start : press->start + PRESS_US;
+    }
+}
+
+
+/*
+ * Copy board.so somewhere private and load it, so each board gets its own
+ * globals.
+ */
+static bool loadBoard(Board* board, uint8_t id, const char* image)
+{
+    char path[] = "/tmp/game_sim_XXXXXX";
+    char buffer[4096];
+    size_t size;
+    FILE* in = fopen(image, "rb");
+    int fd = mkstemp(path);
+    sim_board_attach_t attach;
+    sim_board_run_t run;
+
+    if (!in || fd < 0) {
+        perror(image);
+        return 0;
+    }
+    while ((size = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+        if (write(fd, buffer, size) != (ssize_t) size) {
+            perror(path);
+            return 0;
+        }
+    }
+    fclose(in);
+    close(fd);
+    board->handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    unlink(path);
+    if (!board->handle) {
+        fprintf(stderr, "%s\n", dlerror());
+        return 0;
+    }
+
+    attach = (sim_board_attach_t) dlsym(board->handle, "sim_board_attach");
+    run = (sim_board_run_t) dlsym(board->handle, "sim_board_run");
+    board->navswitch_set = (sim_board_navswitch_set_t) dlsym(board->handle, "sim_board_navswitch_set");
+    board->ir_arrive = (sim_board_ir_arrive_t) dlsym(board->handle, "sim_board_ir_arrive");
+    board->text = (sim_board_text_t) dlsym(board->handle, "sim_board_text");
+    board->pixels = (sim_board_pixels_t) dlsym(board->handle, "sim_board_pixels");
+    board->eeprom = (sim_board_eeprom_t) dlsym(board->handle, "sim_board_eeprom");
+    if (!attach || !run || !board->navswitch_set || !board->ir_arrive
+        || !board->text || !board->pixels || !board->eeprom) {
+        fprintf(stderr, "%s: missing sim_board entry point\n", image);
+        return 0;
+    }
+    attach(&world, id);
+
+    board->stack = malloc(BOARD_STACK_SIZE);
+    getcontext(&board->context);
+    board->context.uc_stack.ss_sp = board->stack;
+    board->context.uc_stack.ss_size = BOARD_STACK_SIZE;
+    board->context.uc_link = &world_context;
+    makecontext(&board->context, run, 0);
+    board->score = NO_SCORE;
+    board->match = board->result_match = 0;
+    board->on_start = board->skipped = 0;
+    return 1;
+}
+
+
+/*
+ * Power a board off, ready to load again with fresh globals. Its script
+ * is kept.
+ */
+static void unloadBoard(Board* board)
+{
+    dlclose(board->handle);
+    free(board->stack);
+    board->handle = NULL;
+    board->wake = 0;
+    board->ir_head = board->ir_count = 0;
+    board->ir_tx_free = 0;
+    board->script_pos = 0;
+    board->random_press = (Press) {0, 0};
+    board->input_change = 0;
+    board->last_text[0] = '\0';
+    board->bytes_sent = board->bytes_dropped = 0;
+    board->bytes_lost = board->bytes_corrupted = 0;
+    board->tx_length = 0;
+}
+
+
+/*
+ * True once the board is showing the result of the match, profiled builds
+ * follow the result with their stats.
+ */
+static bool gameOver(Board* board)
+{
+    const char* text = board->text();
+
+    return !strncmp(text, "WINNER", 6) || !strncmp(text, "LOSER", 5) || !strncmp(text, "TIE", 3);
+}
+
+
+/*
+ * True while the board is on the start screen, showing a role or a level.
+ */
+static bool onStartScreen(Board* board)
+{
+    const char* text = board->text();
+
+    return text[0] && !text[1] && strchr("CS123456789", text[0]);
+}
+
+
+/*
+ * The result a board is showing, 0 won, 1 lost, 2 tied.
+ */
+static uint8_t boardResult(Board* board)
+{
+    const char* text = board->text();
+
+    return text[0] == 'W' ? 0 : text[0] == 'L' ? 1 : 2;
+}
+
+
+static void printDisplay(uint8_t id, Board* board)
+{
+    uint8_t columns[NUM_COLUMNS];
+    uint8_t row, col;
+
+    board->pixels(columns);
+    for (row = 0; row < NUM_ROWS; row++) {
+        printf("           board %d |", id);
+        for (col = 0; col < NUM_COLUMNS; col++) {
+            putchar((columns[col] >> row) & 1 ? '#' : '.');
+        }
+        printf("|\n");
+    }
+}
+
+
+/*
+ * Virtual time of a log time, a count's tick comes at the start of the
+ * count so anything logged after it goes at the end.
+ * @param time - half timer counts
+ */
+static sim_time_t logTime(uint32_t time)
+{
+    uint64_t count = time / 2;
+    sim_time_t start = (count * 1000000 + TIMER_RATE - 1) / TIMER_RATE;
+
+    if (time & 1) {
+        return ((count + 1) * 1000000 + TIMER_RATE - 1) / TIMER_RATE - 1;
+    }
+    return start;
+}
+
+
+/*
+ * Decode a match log, returns the entries or NULL if it is not a log.
+ * @param log - EEPROM contents
+ * @param size - bytes in log
+ * @param count - set to the number of entries
+ */
+static LogEntry* decodeLog(const uint8_t* log, uint32_t size, uint32_t* count)
+{
+    uint32_t last[RECORD_NUM_KINDS] = {0};
+    uint32_t end, pos, delta;
+    uint8_t header, kind, bytes, i;
+    LogEntry* entries;
+
+    if (size < RECORD_HEADER_SIZE || log[0] != 'R' || log[1] != 'L') {
+        return NULL;
+    }
+    end = RECORD_HEADER_SIZE + (log[2] | log[3] << 8);
+    if (end > size) {
+        end = size;
+    }
+    entries = malloc((end / 2 + 1) * sizeof(LogEntry));
+    *count = 0;
+    for (pos = RECORD_HEADER_SIZE; pos < end; pos++) {
+        header = log[pos];
+        kind = header >> RECORD_KIND_SHIFT;
+        delta = header & ((1 << RECORD_KIND_SHIFT) - 1);
+        if (kind >= RECORD_NUM_KINDS) {
+            break;
+        }
+        if (delta >= RECORD_SHORT) {
+            bytes = delta - (RECORD_SHORT - 1);
+            if (pos + bytes + 1 >= end) {
+                break;
+            }
+            for (delta = 0, i = 0; i < bytes; i++) {
+                delta |= (uint32_t) log[++pos] << (8 * i);
+            }
+        }
+        if (++pos >= end) {
+            break;
+        }
+        last[kind] += delta + (kind == RECORD_RX ? RECORD_RX_GAP : 0);
+        entries[*count] = (LogEntry) {last[kind], kind, log[pos]};
+        (*count)++;
+    }
+    return entries;
+}
+
+
+/*
+ * Read a log file to replay into board 0, returns 0 on failure.
+ */
+static bool loadLog(const char* path)
+{
+    static uint8_t log[LOG_MAX];
+    FILE* file = fopen(path, "rb");
+    size_t size;
+
+    if (!file) {
+        perror(path);
+        return 0;
+    }
+    size = fread(log, 1, sizeof(log), file);
+    fclose(file);
+    replay = decodeLog(log, size, &replay_len);
+    if (!replay || !replay_len) {
+        fprintf(stderr, "%s: no match log\n", path);
+        return 0;
+    }
+    return 1;
+}
+
+
+/*
+ * Save the log in a board's EEPROM to <prefix><id>.log, returns 0 on failure.
+ */
+static bool saveLog(const char* prefix, uint8_t id)
+{
+    char path[4096];
+    uint32_t size;
+    const uint8_t* eeprom = boards[id].eeprom(&size);
+    FILE* file;
+
+    if (size < RECORD_HEADER_SIZE || eeprom[0] != 'R' || eeprom[1] != 'L') {
+        fprintf(stderr, "board %d has no match log, build with RECORD=1\n", id);
+        return 0;
+    }
+    size = RECORD_HEADER_SIZE + (eeprom[2] | eeprom[3] << 8);
+    snprintf(path, sizeof(path), "%s%d.log", prefix, id);
+    file = fopen(path, "wb");
+    if (!file || fwrite(eeprom, 1, size, file) != size) {
+        perror(path);
+        return 0;
+    }
+    fclose(file);
+    return 1;
+}
+
+
+static void printEntry(const char* label, const LogEntry* entry)
+{
+    printf("  %s %9.6f  %-4s 0x%02x\n", label, logTime(entry->time) / 1e6,
+           log_kinds[entry->kind], entry->data);
+}
+
+
+/*
+ * Check the replayed board logged the same as the log it was fed, the board
+ * may log more as it runs on past the end. returns 1 if it did.
+ */
+static bool checkReplay(void)
+{
+    uint32_t size, count, i;
+    const uint8_t* eeprom = boards[0].eeprom(&size);
+    LogEntry* entries = decodeLog(eeprom, size, &count);
+
+    if (!entries) {
+        printf("replayed board has no match log, build with RECORD=1\n");
+        return 0;
+    }
+    for (i = 0; i < replay_len; i++) {
+        if (i == count || entries[i].time != replay[i].time
+            || entries[i].kind != replay[i].kind || entries[i].data != replay[i].data) {
+            printf("replay diverges at entry %u of %u\n", i, replay_len);
+            printEntry("logged  ", &replay[i]);
+            if (i < count) {
+                printEntry("replayed", &entries[i]);
+            }
+            free(entries);
+            return 0;
+        }
+    }
+    printf("replay of %u entries matches\n", replay_len);
+    free(entries);
+    return 1;
+}
+
+
+/*
+ * How many boards are done with the match, they have shown its result or
+ * gone on without. A ring's first players can push on from theirs before
+ * the table reaches the last board.
+ */
+static uint8_t boardsOver(void)
+{
+    uint8_t id, over = 0;
+
+    for (id = 0; id < ring_size; id++) {
+        over += boards[id].result_match == world_match || boards[id].match > world_match;
+    }
+    return over;
+}
+
+
+/*
+ * Follow a board's screens, a new start screen is the next match and a
+ * result belongs to the match the board is on.
+ */
+static void followScreens(Board* board)
+{
+    if (onStartScreen(board)) {
+        if (!board->on_start) {
+            board->on_start = 1;
+            if (board->match && board->result_match != board->match) {
+                board->skipped = 1;
+            }
+            board->match++;
+        }
+        return;
+    }
+    board->on_start = 0;
+    if (gameOver(board)) {
+        board->result = boardResult(board);
+        board->result_match = board->match;
+    }
+}
+
+
+/*
+ * Run the boards until all show a result or the time limit passes, a
+ * replay runs to the limit.
+ */
+static void runWorld(sim_time_t limit)
+{
+    uint32_t rematches_left = rematches;
+    uint8_t id, next;
+    sim_time_t wake;
+    Board* board;
+
+    while (world_now < limit) {
+        /* deliver the earliest IR byte if it lands before any board wakes */
+        next = 0xFF;
+        wake = limit;
+        for (id = 0; id < ring_size; id++) {
+            if (boards[id].ir_count && boards[id].ir_queue[boards[id].ir_head].arrive <= wake) {
+                wake = boards[id].ir_queue[boards[id].ir_head].arrive;
+                next = id;
+            }
+        }
+        for (id = 0; id < ring_size; id++) {
+            if (boards[id].input_change < wake) {
+                wake = boards[id].input_change;
+                next = id + 2 * MAX_BOARDS;
+            }
+        }
+        if (replay_pos < replay_len && logTime(replay[replay_pos].time) < wake) {
+            wake = logTime(replay[replay_pos].time);
+            next = 3 * MAX_BOARDS;
+        }
+        for (id = 0; id < ring_size; id++) {
+            if (boards[id].wake < wake) {
+                wake = boards[id].wake;
+                next = id + MAX_BOARDS;
+            }
+        }
+        if (next == 0xFF) {
+            break;
+        }
+        if (wake > world_now) {
+            world_now = wake;
+        }
+
+        if (next < MAX_BOARDS) {
+            board = &boards[next];
+            board->ir_arrive(board->ir_queue[board->ir_head].byte);
+            board->ir_head = (board->ir_head + 1) % IR_QUEUE_SIZE;
+            board->ir_count--;
+            continue;
+        }
+        if (next == 3 * MAX_BOARDS) {
+            if (replay[replay_pos].kind == RECORD_NAV) {
+                boards[0].navswitch_set(replay[replay_pos].data);
+            } else if (replay[replay_pos].kind == RECORD_RX) {
+                boards[0].ir_arrive(replay[replay_pos].data);
+            }
+            replay_pos++;
+            continue;
+        }
+        if (next >= 2 * MAX_BOARDS) {
+            applyInput(&boards[next - 2 * MAX_BOARDS]);
+            continue;
+        }
+
+        id = next - MAX_BOARDS;
+        board = &boards[id];
+        board_wall -= wallTime();
+        swapcontext(&world_context, &board->context);
+        board_wall += wallTime();
+        board_wakes++;
+
+        if (strcmp(board->text(), board->last_text)) {
+            strcpy(board->last_text, board->text());
+            if (verbose) {
+                printf("%9.3f  board %d text \"%s\"\n", world_now / 1e6, id, board->last_text);
+            }
+            followScreens(board);
+        }
+        if (replay) {
+            continue;
+        }
+        if (boardsOver() == ring_size) {
+            if (!rematches_left) {
+                world_running = 0;
+                return;
+            }
+            rematches_left--; // the players push on the end screen for another match
+            world_match++;
+        }
+    }
+}
+
+
+/*
+ * Load the boards and hand them their players' first buttons, returns 0 on
+ * failure.
+ */
+static bool startBoards(const char* image, uint8_t num_boards)
+{
+    uint8_t id;
+
+    world_now = 0;
+    world_running = 1;
+    world_match = 1;
+    for (id = 0; id < num_boards; id++) {
+        if (!loadBoard(&boards[id], id, image)) {
+            return 0;
+        }
+        if (replay) { // the log has the buttons
+            boards[id].input_change = ~(sim_time_t) 0;
+        } else {
+            applyInput(&boards[id]);
+        }
+    }
+    return 1;
+}
+
+
+/*
+ * True if a board went on from a match without showing its result.
+ */
+static bool resultSkipped(void)
+{
+    uint8_t id;
+
+    for (id = 0; id < ring_size; id++) {
+        if (boards[id].skipped) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+
+/*
+ * True if the boards' results for the match fit together, one winner and the
+ * rest losers or at least two tied for the best and the rest losers.
+ */
+static bool resultsAgree(void)
+{
+    uint8_t count[3] = {0};
+    uint8_t id;
+
+    for (id = 0; id < ring_size; id++) {
+        count[boards[id].result]++;
+    }
+    return count[0] == 1 ? !count[2] : !count[0] && count[2] >= 2;
+}
+
+
+/*
+ * Play matches back to back on fresh boards, seeds counting up from seed,
+ * and report how they went. returns 1 if every match finished with the
+ * boards agreeing on the result.
+ */
+static bool soak(const char* image, uint32_t seed, uint32_t matches, sim_time_t limit)
+{
+    static const char* const results[] = {"won", "lost", "tied"};
+    uint32_t scores[256] = {0};
+    uint32_t results0[3] = {0};
+    uint32_t bad_seeds[SOAK_SEEDS_SHOWN];
+    uint32_t hung = 0, skipped = 0, disagreed = 0, num_bad = 0, match, i;
+    uint64_t sent = 0, lost = 0, corrupted = 0, dropped = 0;
+    double virtual_s = 0, wall = wallTime();
+    uint8_t id;
+
+    for (match = 0; match < matches; match++) {
+        seedWorld(seed + match);
+        if (!startBoards(image, ring_size)) {
+            return 0;
+        }
+        runWorld(limit);
+        virtual_s += world_now / 1e6;
+        if (world_running || resultSkipped() || !resultsAgree()) {
+            if (world_running) {
+                hung++;
+            } else if (resultSkipped()) {
+                skipped++;
+            } else {
+                disagreed++;
+            }
+            if (num_bad < SOAK_SEEDS_SHOWN) {
+                bad_seeds[num_bad++] = seed + match;
+            }
+        } else {
+            results0[boards[0].result]++;
+        }
+        for (id = 0; id < ring_size; id++) {
+            if (boards[id].score != NO_SCORE) {
+                scores[boards[id].score]++;
+            }
+            sent += boards[id].bytes_sent;
+            lost += boards[id].bytes_lost;
+            corrupted += boards[id].bytes_corrupted;
+            dropped += boards[id].bytes_dropped;
+            unloadBoard(&boards[id]);
+        }
+    }
+    wall = wallTime() - wall;
+
+    printf("%u matches in %.2f s wall, %.1f matches/s, %.1f s virtual each\n",
+           matches, wall, matches / wall, virtual_s / matches);
+    printf("hung %u (%.2f%%), skipped a result %u (%.2f%%), disagreed on the result %u (%.2f%%)",
+           hung, 100.0 * hung / matches, skipped, 100.0 * skipped / matches,
+           disagreed, 100.0 * disagreed / matches);
+    for (i = 0; i < num_bad; i++) {
+        printf("%s%u", i ? " " : ", seeds ", bad_seeds[i]);
+    }
+    printf("\nboard 0 %s %u, %s %u, %s %u\n", results[0], results0[0], results[1], results0[1],
+           results[2], results0[2]);
+    printf("catches in a round:");
+    for (i = 0; i < 256; i++) {
+        if (scores[i]) {
+            printf(" %u:%u", i, scores[i]);
+        }
+    }
+    printf("\nIR bytes %llu sent, %llu lost, %llu corrupted, %llu dropped\n",
+           (unsigned long long) sent, (unsigned long long) lost,
+           (unsigned long long) corrupted, (unsigned long long) dropped);
+    printf("game code %.0f ns per board wake over %llu wakes\n",
+           board_wakes ? board_wall * 1e9 / board_wakes : 0, (unsigned long long) board_wakes);
+    return !hung && !skipped && !disagreed;
+}
+
+
+int main(int argc, char** argv)
+{
+    char image[4096];
+    const char* scripts[2] = {NULL, NULL};
+    const char* log_prefix = NULL;
+    const char* replay_path = NULL;
+    sim_time_t limit = (sim_time_t) DEFAULT_LIMIT_S * 1000000;
+    uint32_t seed = 0, matches = 0;
+    double wall;
+    uint8_t id, num_boards;
+    int opt;
+
+    snprintf(image, sizeof(image), "%s/board.so", dirname(strdup(argv[0])));
+    while ((opt = getopt(argc, argv, "vs:t:d:f:a:b:l:r:n:p:c:j:w:k:")) != -1) {
+        switch (opt) {
+        case 'v': verbose = 1; break;
+        case 's': seed = strtoul(optarg, NULL, 0); break;
+        case 't': limit = (sim_time_t) (atof(optarg) * 1e6); break;
+        case 'd': ir_delay = strtoul(optarg, NULL, 0); break;
+        case 'f': snprintf(image, sizeof(image), "%s", optarg); break;
+        case 'a': scripts[0] = optarg; break;
+        case 'b': scripts[1] = optarg; break;
+        case 'l': log_prefix = optarg; break;
+        case 'r': replay_path = optarg; break;
+        case 'n': matches = strtoul(optarg, NULL, 0); break;
+        case 'p': ir_drop = atof(optarg) / 100; break;
+        case 'c': ir_corrupt = atof(optarg) / 100; break;
+        case 'j': ir_jitter = strtoul(optarg, NULL, 0); break;
+        case 'w': rematches = strtoul(optarg, NULL, 0); break;
+        case 'k': ring_size = strtoul(optarg, NULL, 0); break;
+        default:
+            fprintf(stderr, "usage: %s [-v] [-s seed] [-t seconds] [-d delay_us] "
+                    "[-f board.so] [-a script] [-b script] [-l prefix] [-r log] "
+                    "[-n matches] [-p drop_%%] [-c corrupt_%%] [-j jitter_us] [-w rematches] [-k boards]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (ring_size < 2 || ring_size > MAX_BOARDS) {
+        fprintf(stderr, "%s: a ring has 2 to %d boards\n", argv[0], MAX_BOARDS);
+        return 2;
+    }
+    num_boards = ring_size;
+    for (id = 0; id < 2; id++) {
+        if (scripts[id] && !loadScript(&boards[id], scripts[id])) {
+            return 1;
+        }
+    }
+    if (matches && !replay_path) {
+        return soak(image, seed, matches, limit) ? 0 : 1;
+    }
+    seedWorld(seed);
+
+    if (replay_path) {
+        if (!loadLog(replay_path)) {
+            return 1;
+        }
+        limit = logTime(replay[replay_len - 1].time) + REPLAY_TAIL_US;
+        num_boards = 1;
+        ring_size = 2; // the board it sends to is left out
+        boards[1].wake = boards[1].input_change = ~(sim_time_t) 0;
+    }
+    if (!startBoards(image, num_boards)) {
+        return 1;
+    }
+
+    wall = wallTime();
+    runWorld(limit);
+    wall = wallTime() - wall;
+
+    for (id = 0; id < num_boards; id++) {
+        printf("board %d: \"%s\", %u IR bytes sent, %u dropped", id, boards[id].text(),
+               boards[id].bytes_sent, boards[id].bytes_dropped);
+        if (ir_drop > 0 || ir_corrupt > 0) {
+            printf(", %u lost, %u corrupted", boards[id].bytes_lost, boards[id].bytes_corrupted);
+        }
+        if (boards[id].skipped) {
+            printf(", skipped a result");
+        }
+        printf("\n");
+        if (verbose || (world_running && !replay)) {
+            printDisplay(id, &boards[id]);
+        }
+        if (log_prefix && !saveLog(log_prefix, id)) {
+            return 1;
+        }
+    }
+    if (replay) {
+        return checkReplay() ? 0 : 1;
+    }
+    printf("%s after %.3f s virtual in %.3f s wall (%.0fx real time)\n",
+           world_running ? "HUNG" : "finished", world_now / 1e6, wall,
+           wall > 0 ? world_now / 1e6 / wall : 0);
+    return world_running || resultSkipped() ? 1 : 0;
+}
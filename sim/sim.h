@@ -0,0 +1,69 @@
+/** @file sim.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief interface between the simulated world and a simulated board
+ *
+ *  The firmware (game.c and friends linked against the host stand-ins in
+ *  sim/hal) is built into board.so. The world (sim.c) loads one private copy
+ *  of board.so per funkit, so every board gets its own globals just like its
+ *  own SRAM, and runs each copy's main() as a coroutine on a virtual clock.
+ *
+ *  Board -> world calls go through the sim_world_t table handed over in
+ *  sim_board_attach(). World -> board calls are the sim_board_* functions
+ *  below, looked up with dlsym().
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Virtual time is kept in microseconds since power on. */
+typedef uint64_t sim_time_t;
+
+/* One IR byte at 2400 baud with start and stop bits. */
+#define SIM_IR_BYTE_US 4167
+
+typedef struct sim_world_s
+{
+    /* Suspend the calling board until the virtual clock reaches wake. */
+    void (*wait_until) (uint8_t board, sim_time_t wake);
+    /* Current virtual time. */
+    sim_time_t (*now) (void);
+    /* Start transmitting a byte on the board's IR LED. */
+    void (*ir_putc) (uint8_t board, uint8_t byte);
+} sim_world_t;
+
+
+/* Entry points exported by board.so. */
+typedef void (*sim_board_attach_t) (const sim_world_t* world, uint8_t id);
+typedef void (*sim_board_run_t) (void);
+typedef void (*sim_board_navswitch_set_t) (uint8_t down_mask);
+typedef void (*sim_board_ir_arrive_t) (uint8_t byte);
+typedef const char* (*sim_board_text_t) (void);
+typedef void (*sim_board_pixels_t) (uint8_t* columns);
+typedef const uint8_t* (*sim_board_eeprom_t) (uint32_t* size);
+
+/* Hook the board up to the world, must be called before sim_board_run. */
+void sim_board_attach (const sim_world_t* world, uint8_t id);
+
+/* Power on: runs the firmware's main(), never returns. */
+void sim_board_run (void);
+
+/* Set which navswitch buttons are held, bit n is navswitch button n. */
+void sim_board_navswitch_set (uint8_t down_mask);
+
+/* A byte has finished arriving at the board's IR receiver. */
+void sim_board_ir_arrive (uint8_t byte);
+
+/* Text currently shown by tinygl, empty when drawing points. */
+const char* sim_board_text (void);
+
+/* Copy out the LED matrix, one byte per column with bit n for row n. */
+void sim_board_pixels (uint8_t* columns);
+
+/* The board's EEPROM, size is set to its length in bytes. */
+const uint8_t* sim_board_eeprom (uint32_t* size);
+
+#endif
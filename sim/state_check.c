@@ -0,0 +1,140 @@
+/** @file state_check.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief checks match state snapshots in a board image built with the same
+ *  options as this tool. A snapshot must restore to the same bytes, and one
+ *  with any single byte changed to any other value must be turned down
+ *  without touching the state it was restored over, as must one of blank
+ *  or erased storage. Exits 1 on the first failure.
+ *
+ *  Usage: state_check [board.so]
+ */
+
+#include <dlfcn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "state.h"
+
+#define DEFAULT_IMAGE "./sim/board.so"
+#define PATTERNS 16 // different states to snapshot
+
+typedef void (*state_snapshot_t)(const game_state_t* state, uint8_t* snapshot);
+typedef bool (*state_restore_t)(game_state_t* state, const uint8_t* snapshot);
+
+static state_snapshot_t snapshot_fn;
+static state_restore_t restore_fn;
+
+
+/*
+ * Fill a state's bytes from a seed, every field gets values the game would
+ * never leave in it as well as ones it would.
+ */
+static void fillState(game_state_t* state, unsigned seed)
+{
+    uint8_t* bytes = (uint8_t*) state;
+    size_t i;
+
+    for (i = 0; i < sizeof(game_state_t); i++) {
+        seed = seed * 1103515245 + 12345;
+        bytes[i] = seed >> 16;
+    }
+}
+
+
+/*
+ * Snapshot one state, restore it and then every corruption of it.
+ * returns the number of corrupt snapshots turned down, 0 on a failure
+ */
+static unsigned long checkPattern(unsigned seed)
+{
+    game_state_t state, target, before;
+    uint8_t snapshot[STATE_SNAPSHOT_SIZE];
+    uint8_t corrupt[STATE_SNAPSHOT_SIZE];
+    unsigned long caught = 0;
+    size_t i;
+    unsigned flip;
+
+    fillState(&state, seed);
+    snapshot_fn(&state, snapshot);
+    memset(&target, 0, sizeof(target));
+    if (!restore_fn(&target, snapshot) || memcmp(&target, &state, sizeof(state))) {
+        printf("pattern %u: a good snapshot did not restore to the same state\n", seed);
+        return 0;
+    }
+
+    fillState(&before, ~seed);
+    for (i = 0; i < STATE_SNAPSHOT_SIZE; i++) {
+        for (flip = 1; flip < 256; flip++) {
+            memcpy(corrupt, snapshot, sizeof(corrupt));
+            corrupt[i] ^= flip;
+            target = before;
+            if (restore_fn(&target, corrupt)) {
+                printf("pattern %u: byte %zu xor 0x%02x was restored\n", seed, i, flip);
+                return 0;
+            }
+            if (memcmp(&target, &before, sizeof(before))) {
+                printf("pattern %u: byte %zu xor 0x%02x changed the state\n", seed, i, flip);
+                return 0;
+            }
+            caught++;
+        }
+    }
+    return caught;
+}
+
+
+/*
+ * Check that blank or erased storage is not taken for a snapshot.
+ * returns 1 if snapshots of all 0x00 and all 0xFF are both turned down
+ */
+static int checkBlank(void)
+{
+    game_state_t target;
+    uint8_t blank[STATE_SNAPSHOT_SIZE];
+    int fill;
+
+    for (fill = 0x00; fill <= 0xFF; fill += 0xFF) {
+        memset(blank, fill, sizeof(blank));
+        if (restore_fn(&target, blank)) {
+            printf("a snapshot of all 0x%02X was restored\n", fill);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+
+int main(int argc, char** argv)
+{
+    const char* image = argc > 1 ? argv[1] : DEFAULT_IMAGE;
+    void* handle = dlopen(image, RTLD_NOW | RTLD_LOCAL);
+    unsigned long caught = 0, pattern_caught;
+    unsigned seed;
+
+    if (!handle) {
+        fprintf(stderr, "%s\n", dlerror());
+        return 1;
+    }
+    snapshot_fn = (state_snapshot_t) dlsym(handle, "state_snapshot");
+    restore_fn = (state_restore_t) dlsym(handle, "state_restore");
+    if (!snapshot_fn || !restore_fn) {
+        fprintf(stderr, "%s: missing state_snapshot or state_restore\n", image);
+        return 1;
+    }
+
+    if (!checkBlank()) {
+        return 1;
+    }
+    for (seed = 1; seed <= PATTERNS; seed++) {
+        pattern_caught = checkPattern(seed);
+        if (!pattern_caught) {
+            return 1;
+        }
+        caught += pattern_caught;
+    }
+    printf("%d states of %zu bytes round trip, %lu corrupt snapshots turned down\n",
+           PATTERNS, sizeof(game_state_t), caught);
+    dlclose(handle);
+    return 0;
+}
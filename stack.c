@@ -0,0 +1,52 @@
+/** @file stack.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief stack high water mark
+ */
+
+#include "system.h"
+#include "stack.h"
+
+extern uint8_t _end;    // first byte after .bss, from the linker
+extern uint8_t __stack; // top of RAM, where the stack starts
+
+/* left alone by the startup code, which only clears .bss */
+static uint16_t stack_noise_word __attribute__ ((section (".noinit")));
+
+
+/*
+ * Paint the free RAM, runs from .init3 once the stack pointer is set and
+ * before .data and .bss are filled in, so nothing is on the stack yet. It is
+ * naked so it falls through to .init4 and cannot use the stack itself. What
+ * the RAM powered up holding is folded into stack_noise_word on the way.
+ */
+void stack_paint (void) __attribute__ ((naked, used, section (".init3")));
+
+void stack_paint (void)
+{
+    uint8_t* pos = &_end;
+    uint16_t noise = 0;
+
+    while (pos <= &__stack) {
+        noise = (noise << 1 | noise >> 15) ^ *pos;
+        *pos++ = STACK_PAINT;
+    }
+    stack_noise_word = noise;
+}
+
+
+uint16_t stack_unused (void)
+{
+    const uint8_t* pos = &_end;
+
+    while (pos <= &__stack && *pos == STACK_PAINT) {
+        pos++;
+    }
+    return pos - &_end;
+}
+
+
+uint16_t stack_noise (void)
+{
+    return stack_noise_word;
+}
@@ -0,0 +1,35 @@
+/** @file stack.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief stack high water mark. Before main runs, the RAM between the end of
+ *  .bss and the top of the stack is painted with a known byte, anything the
+ *  stack has since grown over no longer holds it. Counting the painted bytes
+ *  left above .bss gives the RAM the game has never touched, which is the
+ *  headroom left for new variables and deeper calls. The game has no heap.
+ */
+
+#ifndef STACK_H
+#define STACK_H
+
+#include "system.h"
+
+#define STACK_PAINT 0xC5
+
+/*
+ * Bytes between the end of .bss and the deepest the stack has reached so far,
+ * scans up from .bss so it takes longer the more is free. Interrupts only
+ * ever push below the deepest point so it is safe with them on.
+ * returns the free bytes, 0 on the host simulator which does not model the
+ * funkit's RAM
+ */
+uint16_t stack_unused (void);
+
+/*
+ * What the free RAM held at power on, folded into a word just before it was
+ * painted. Each RAM cell powers up one way or the other depending on the
+ * chip, so two boards almost never have the same word.
+ * returns the word, a different one for each board on the host simulator
+ */
+uint16_t stack_noise (void);
+
+#endif
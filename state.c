@@ -0,0 +1,42 @@
+/** @file state.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief match state snapshots
+ */
+
+#include <string.h>
+#include "system.h"
+#include "message.h"
+#include "state.h"
+
+
+/*
+ * CRC-8 of a state's bytes, the same one the IR frames use.
+ */
+static uint8_t state_crc (const uint8_t* bytes)
+{
+    uint8_t crc = MESSAGE_CRC_INIT;
+    uint8_t i;
+
+    for (i = 0; i < sizeof (game_state_t); i++) {
+        crc = message_crc8 (crc, bytes[i]);
+    }
+    return crc;
+}
+
+
+void state_snapshot (const game_state_t* state, uint8_t* snapshot)
+{
+    memcpy (snapshot, state, sizeof (game_state_t));
+    snapshot[sizeof (game_state_t)] = state_crc (snapshot);
+}
+
+
+bool state_restore (game_state_t* state, const uint8_t* snapshot)
+{
+    if (state_crc (snapshot) != snapshot[sizeof (game_state_t)]) {
+        return 0;
+    }
+    memcpy (state, snapshot, sizeof (game_state_t));
+    return 1;
+}
@@ -0,0 +1,101 @@
+/** @file state.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief everything a match has got to, in one struct that main owns and
+ *  the game's tasks share. Counts and flags are whole bytes, but for the
+ *  RING has_shot bit, the catcher's paddle is kept as a mask of the rows it
+ *  covers and the shooter as its row (both always sit in the last column)
+ *  and on the AVR, where nothing is aligned, the struct has no padding. The
+ *  host pads the boing and ball motion structs inside it, so the sim's
+ *  snapshots are bigger than a board's. A snapshot is the struct's bytes and
+ *  a CRC-8 of them, something to checksum, keep for a replay or send to the
+ *  other board to resync it. Only boards built with the same options can
+ *  share snapshots, the options add fields.
+ */
+
+#ifndef STATE_H
+#define STATE_H
+
+#include "system.h"
+#include "tinygl.h"
+#include "boing.h"
+#include "ball.h"
+#include "ring.h"
+
+typedef struct game_state_s
+{
+    boing_state_t ball;            // loaded or in the air, without MULTI_BALL
+    ball_motion_t ball_motion;
+#ifdef MULTI_BALL
+    ball_pool_t ball_pool;         // balls in the air, the shooter's or the catcher's
+#endif
+    char role;                     // 'C' or 'S', or 'W' watching another pair in a RING
+    uint8_t round;                 // round_state_t, where the round has got to
+    uint8_t balls_caught;
+    uint8_t other_player_score;
+    uint8_t turns;                 // rounds over, 2 ends the match
+    uint8_t seed_tick;             // counts input ticks, reseeds the wind gusts
+    uint8_t num_balls_fired;
+    uint8_t num_balls_received;
+    uint8_t paddle;                // rows the catcher paddle covers, bit n for row n
+    tinygl_coord_t shooter_row;
+#ifdef BALL_PATH
+    uint8_t path_wait_steps;       // ball steps until a planned ball reaches the catcher's screen
+#endif
+#ifdef AI
+    uint8_t ai_wait;               // input ticks until the computer may move the paddle again
+#endif
+#ifdef RING
+    ring_table_t table;            // scores as of the last round this board heard about
+    uint8_t has_shot : 1;          // this board has held the token this match
+#endif
+} game_state_t;
+
+#ifdef MULTI_BALL
+#define STATE_POOL_SIZE sizeof (ball_pool_t)
+#else
+#define STATE_POOL_SIZE 0
+#endif
+
+#ifdef BALL_PATH
+#define STATE_PATH_SIZE 1
+#else
+#define STATE_PATH_SIZE 0
+#endif
+
+#ifdef AI
+#define STATE_AI_SIZE 1
+#else
+#define STATE_AI_SIZE 0
+#endif
+
+#ifdef RING
+#define STATE_RING_SIZE (sizeof (ring_table_t) + 1) // the table then has_shot's byte
+#else
+#define STATE_RING_SIZE 0
+#endif
+
+#ifdef __AVR__
+_Static_assert (sizeof (game_state_t) == sizeof (boing_state_t) + sizeof (ball_motion_t)
+                + STATE_POOL_SIZE + 9 + sizeof (tinygl_coord_t) + STATE_PATH_SIZE
+                + STATE_AI_SIZE + STATE_RING_SIZE, "game_state_t is padded");
+#endif
+
+#define STATE_SNAPSHOT_SIZE (sizeof (game_state_t) + 1) // [bytes] the state then its CRC
+
+/*
+ * Copy the state out with a check byte.
+ * @param state - state to copy
+ * @param snapshot - STATE_SNAPSHOT_SIZE bytes to fill
+ */
+void state_snapshot (const game_state_t* state, uint8_t* snapshot);
+
+/*
+ * Take the state back from a snapshot, a corrupt one is ignored.
+ * @param state - state to overwrite
+ * @param snapshot - STATE_SNAPSHOT_SIZE bytes from state_snapshot
+ * returns 0, leaving state alone, if the check byte does not match
+ */
+bool state_restore (game_state_t* state, const uint8_t* snapshot);
+
+#endif
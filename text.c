@@ -0,0 +1,45 @@
+/** @file text.c
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief building scrolling text for the report screens
+ */
+
+#include <avr/pgmspace.h>
+#include "system.h"
+#include "text.h"
+
+
+char* text_append_number (char* pos, uint32_t value)
+{
+    char digits[10];
+    uint8_t count = 0;
+
+    do {
+        digits[count++] = '0' + value % 10;
+        value /= 10;
+    } while (value);
+    while (count) {
+        *pos++ = digits[--count];
+    }
+    return pos;
+}
+
+
+char* text_append (char* pos, const char* text)
+{
+    while (*text) {
+        *pos++ = *text++;
+    }
+    return pos;
+}
+
+
+char* text_append_P (char* pos, const char* text)
+{
+    char c;
+
+    while ((c = pgm_read_byte (text++))) {
+        *pos++ = c;
+    }
+    return pos;
+}
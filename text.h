@@ -0,0 +1,38 @@
+/** @file text.h
+ *  @author Hayden Taylor, Shawn Richards
+ *  @date 17 October 2026
+ *  @brief building scrolling text for the report screens without printf,
+ *  which would not fit alongside the game. Each call appends at pos and
+ *  returns the position after what it wrote, the caller ends the string.
+ */
+
+#ifndef TEXT_H
+#define TEXT_H
+
+#include "system.h"
+
+/*
+ * Append a number in decimal.
+ * @param pos - where to write
+ * @param value - number to write
+ * returns the position after the number
+ */
+char* text_append_number (char* pos, uint32_t value);
+
+/*
+ * Append a string from RAM, without its terminator.
+ * @param pos - where to write
+ * @param text - string to copy
+ * returns the position after the text
+ */
+char* text_append (char* pos, const char* text);
+
+/*
+ * Append a string kept in program memory, without its terminator.
+ * @param pos - where to write
+ * @param text - string in program memory, PSTR or PROGMEM
+ * returns the position after the text
+ */
+char* text_append_P (char* pos, const char* text);
+
+#endif